@@ -0,0 +1,102 @@
+#include "dancedance_record.hpp"
+
+#include <iostream>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std::chrono;
+
+constexpr size_t Recorder::capacity;
+
+// opens the log and starts the writer thread
+Recorder::Recorder(std::string const& path, std::string const& melody) :
+    _melody(melody),
+    _epoch(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count())
+{
+    if(path.empty())
+        return;
+    _fd = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if(_fd < 0) {
+        std::cerr << "failed to open session log " << path << std::endl;
+        return;
+    }
+    push({record::START, 0, false, 0, steady_clock::now()});
+    _writer = std::thread(&Recorder::drain, this);
+}
+
+// flushes pending events and closes the log
+Recorder::~Recorder() {
+    if(_fd < 0)
+        return;
+    _done.store(true, std::memory_order_release);
+    _writer.join();
+    close(_fd);
+}
+
+void Recorder::keystroke(char key, bool hit) {
+    if(_fd >= 0)
+        push({record::KEYSTROKE, key, hit, 0, steady_clock::now()});
+}
+
+void Recorder::end(size_t count) {
+    if(_fd >= 0)
+        push({record::END, 0, false, static_cast<std::uint32_t>(count), steady_clock::now()});
+}
+
+// called from the game loop only
+void Recorder::push(Event const& event) {
+    size_t head = _head.load(std::memory_order_relaxed);
+    // a full ring means the writer is stalled, wait for it rather than lose a record
+    while(head - _tail.load(std::memory_order_acquire) == capacity)
+        std::this_thread::yield();
+    _ring[head & (capacity - 1)] = event;
+    _head.store(head + 1, std::memory_order_release);
+}
+
+// called from the writer thread only
+void Recorder::drain() {
+    std::vector<char> buffer;
+    steady_clock::time_point last;
+    for(;;) {
+        bool done = _done.load(std::memory_order_acquire);
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        size_t head = _head.load(std::memory_order_acquire);
+
+        if(tail == head) {
+            if(done)
+                break;
+            std::this_thread::sleep_for(milliseconds(1));
+            continue;
+        }
+
+        buffer.clear();
+        for(; tail != head; ++tail) {
+            Event const& event = _ring[tail & (capacity - 1)];
+            char scratch[32];
+            char* out = scratch;
+            *out++ = event.tag;
+            if(event.tag == record::START) {
+                out = record::encode_varint(out, _epoch);
+                out = record::encode_varint(out, _melody.size());
+                buffer.insert(buffer.end(), scratch, out);
+                buffer.insert(buffer.end(), _melody.begin(), _melody.end());
+            }
+            else {
+                out = record::encode_varint(out, duration_cast<microseconds>(event.when - last).count());
+                if(event.tag == record::KEYSTROKE) {
+                    *out++ = event.key;
+                    *out++ = event.hit;
+                }
+                else
+                    out = record::encode_varint(out, event.count);
+                buffer.insert(buffer.end(), scratch, out);
+            }
+            last = event.when;
+        }
+        _tail.store(tail, std::memory_order_release);
+
+        if(write(_fd, buffer.data(), buffer.size()) != static_cast<ssize_t>(buffer.size()))
+            std::cerr << "failed to write session log" << std::endl;
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef DANCEDANCE_RECORD_HPP
+#define DANCEDANCE_RECORD_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+/* Session logs are append-only binary files, each one a sequence of records
+ * starting with a tag byte. All integers are LEB128 varints and timestamps are
+ * microseconds, relative to the previous record of the session.
+ *
+ *   'S' start      <epoch timestamp> <melody size> <melody bytes>
+ *   'K' keystroke  <delta> <key> <judgement: 1 if the note was hit, else 0>
+ *   'E' end        <delta> <number of notes successfully typed>
+ *
+ * Several sessions can follow each other in the same file.
+ */
+namespace record {
+
+enum Tag : char {
+    START = 'S',
+    KEYSTROKE = 'K',
+    END = 'E'
+};
+
+// append `value' to `out' as a varint, returns the new end
+inline char* encode_varint(char* out, std::uint64_t value) {
+    while(value >= 0x80) {
+        *out++ = static_cast<char>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<char>(value);
+    return out;
+}
+
+// read a varint from [in, end), returns nullptr on truncated input
+inline char const* decode_varint(char const* in, char const* end, std::uint64_t& value) {
+    value = 0;
+    for(unsigned shift = 0; in != end and shift < 64; shift += 7) {
+        std::uint8_t byte = *in++;
+        value |= std::uint64_t(byte & 0x7f) << shift;
+        if(not (byte & 0x80))
+            return in;
+    }
+    return nullptr;
+}
+
+}
+
+/* This class records a game session to a log file.
+ *
+ * The game loop only pushes fixed-size events to a lock-free single producer
+ * single consumer ring; encoding and writing happen in a background thread
+ * started upon construction and joined upon deletion.
+ *
+ * An empty path disables recording.
+ */
+class Recorder {
+
+    struct Event {
+        record::Tag tag;
+        char key;
+        bool hit;
+        std::uint32_t count;
+        std::chrono::steady_clock::time_point when;
+    };
+
+    static constexpr size_t capacity = 1024; // must be a power of 2
+
+    std::array<Event, capacity> _ring;
+    std::atomic<size_t> _head{0}, _tail{0};
+    std::atomic<bool> _done{false};
+
+    std::string _melody;
+    std::uint64_t _epoch;
+    int _fd = -1;
+    std::thread _writer;
+
+    void push(Event const& event);
+    void drain();
+
+    public:
+    Recorder(std::string const& path, std::string const& melody);
+    ~Recorder();
+
+    void keystroke(char key, bool hit);
+    void end(size_t count);
+};
+
+#endif
@@ -0,0 +1,201 @@
+/* .~= dance dance replay =~.
+ *
+ * Plays dance dance fingers without a human: the game is spawned on a pseudo
+ * terminal, so that TermiOS really switches a tty to raw mode, and keystrokes
+ * are injected according to a scripted timeline.
+ *
+ * The timeline is a text file with one keystroke per line:
+ *
+ *   <offset in microseconds from the first note> <key>
+ *
+ * Lines starting with a `#' are ignored. A keystroke is never sent before the
+ * game has printed the note it answers, so a slow game delays the timeline.
+ *
+ * For each keystroke, the harness measures the input-to-echo latency, i.e. the
+ * time between the key being written to the terminal and the next byte
+ * printed by the game. Latencies of all runs are aggregated and summarized.
+ *
+ * Each run gets a deadline: the last offset of the timeline plus a grace
+ * period. A game still running by then, say blocked on a key the timeline
+ * never sends, is killed and its run counted as failed.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <stdexcept>
+#include <cerrno>
+
+#include <pty.h>
+#include <signal.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+using Clock = std::chrono::steady_clock;
+
+// time left to a game after the last keystroke of the timeline
+constexpr std::chrono::seconds Grace(5);
+
+struct Keystroke {
+    std::chrono::microseconds offset;
+    char key;
+};
+
+static
+std::vector<Keystroke> load_timeline(std::string const& path) {
+    std::ifstream ifs(path);
+    if(not ifs)
+        throw std::runtime_error("invalid timeline: " + path);
+
+    std::vector<Keystroke> timeline;
+    std::string line;
+    while(std::getline(ifs, line)) {
+        if(line.empty() or line[0] == '#')
+            continue;
+        std::istringstream iss(line);
+        long long offset;
+        char key;
+        if(not (iss >> offset >> key))
+            throw std::runtime_error("invalid timeline entry: " + line);
+        timeline.push_back({std::chrono::microseconds(offset), key});
+    }
+    if(timeline.empty())
+        throw std::runtime_error("empty timeline: " + path);
+    return timeline;
+}
+
+// outcome of a single game
+struct Run {
+    std::string output;
+    std::vector<Clock::duration> latencies;
+    int status = -1;
+    bool timed_out = false;
+};
+
+// read whatever the game has printed, waiting until `deadline' at most
+// returns false once the game has closed its terminal or the deadline passed
+static
+bool pump(int master, std::string& output, Clock::time_point deadline) {
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+    if(left.count() <= 0)
+        return false;
+    pollfd pfd = {master, POLLIN, 0};
+    int ready = poll(&pfd, 1, static_cast<int>(std::min<long long>(left.count(), 1000)));
+    if(ready <= 0)
+        return ready == 0 or errno == EINTR;
+    char buffer[256];
+    ssize_t n = read(master, buffer, sizeof(buffer));
+    if(n <= 0)
+        return false;
+    output.append(buffer, n);
+    return true;
+}
+
+static
+Run play(std::string const& game, std::vector<Keystroke> const& timeline) {
+    int master;
+    pid_t pid = forkpty(&master, nullptr, nullptr, nullptr);
+    if(pid < 0)
+        throw std::runtime_error("failed to spawn a pseudo terminal");
+    if(pid == 0) {
+        execl(game.c_str(), game.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+
+    Run run;
+    bool alive = true;
+    auto const deadline = Clock::now() + timeline.back().offset + Grace;
+
+    // the first note follows the banner line
+    while(alive) {
+        auto eol = run.output.find('\n');
+        if(eol != std::string::npos and eol + 1 < run.output.size())
+            break;
+        alive = pump(master, run.output, deadline);
+    }
+
+    auto start = Clock::now();
+    for(Keystroke const& keystroke : timeline) {
+        if(not alive)
+            break;
+        std::this_thread::sleep_until(std::min(start + keystroke.offset, deadline));
+
+        size_t seen = run.output.size();
+        auto sent = Clock::now();
+        if(write(master, &keystroke.key, 1) != 1)
+            break;
+        while(alive and run.output.size() == seen)
+            alive = pump(master, run.output, deadline);
+        if(run.output.size() != seen)
+            run.latencies.push_back(Clock::now() - sent);
+    }
+
+    // drain the end of game message
+    while(alive)
+        alive = pump(master, run.output, deadline);
+    if(Clock::now() >= deadline) {
+        kill(pid, SIGKILL);
+        run.timed_out = true;
+    }
+    close(master);
+
+    int wstatus;
+    if(waitpid(pid, &wstatus, 0) == pid and WIFEXITED(wstatus) and not run.timed_out)
+        run.status = WEXITSTATUS(wstatus);
+    return run;
+}
+
+static
+int usage(char const *progname) {
+    std::cerr << "usage: " << progname << " <game> <timeline> [runs]" << std::endl;
+    return 1;
+}
+
+int main(int argc, char * argv[]) {
+    if(argc != 3 and argc != 4)
+        return usage(argv[0]);
+
+    int runs = argc == 4 ? std::stoi(argv[3]) : 1;
+    if(runs <= 0)
+        return usage(argv[0]);
+
+    std::vector<Keystroke> timeline = load_timeline(argv[2]);
+
+    std::vector<Clock::duration> latencies;
+    int winners = 0, timeouts = 0;
+    std::string transcript;
+    for(int i = 0; i < runs; ++i) {
+        Run run = play(argv[1], timeline);
+        if(run.status == 0)
+            ++winners;
+        timeouts += run.timed_out;
+        if(i == 0)
+            transcript = run.output;
+        latencies.insert(latencies.end(), run.latencies.begin(), run.latencies.end());
+    }
+
+    std::cout << "--<< first run transcript >>--" << std::endl
+              << transcript << std::endl
+              << "--<< " << winners << "/" << runs << " winning runs >>--" << std::endl;
+    if(timeouts)
+        std::cout << timeouts << " runs killed after their deadline" << std::endl;
+
+    if(not latencies.empty()) {
+        std::sort(latencies.begin(), latencies.end());
+        auto us = [&latencies](double q) {
+            size_t index = static_cast<size_t>(q * (latencies.size() - 1));
+            return std::chrono::duration_cast<std::chrono::microseconds>(latencies[index]).count();
+        };
+        std::cout << "input-to-echo latency over " << latencies.size() << " keystrokes (us):" << std::endl
+                  << "  min " << us(0.) << "  median " << us(.5) << "  p99 " << us(.99)
+                  << "  max " << us(1.) << std::endl;
+    }
+
+    return winners == runs ? 0 : 1;
+}
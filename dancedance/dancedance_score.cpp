@@ -0,0 +1,186 @@
+/* .~= dance dance scorer =~.
+ *
+ * Replays session logs written by `solution/dancedance <log>' and recomputes
+ * the leaderboard and some statistics from them. Logs are memory mapped and
+ * parsed by a pool of threads, each one with its own accumulators, merged
+ * once all logs have been processed.
+ */
+
+#include "dancedance_record.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// a fully parsed session
+struct Session {
+    std::string log;
+    std::uint64_t epoch;  //< start time, in microseconds since epoch
+    std::uint64_t duration; //< from start to end, in microseconds
+    size_t count;
+    bool winner;
+};
+
+// per-thread accumulators
+struct Stats {
+    size_t sessions = 0;
+    size_t truncated = 0;
+    size_t keystrokes = 0;
+    size_t hits = 0;
+    std::uint64_t keystroke_time = 0;
+    std::vector<Session> winners;
+
+    void merge(Stats const& other) {
+        sessions += other.sessions;
+        truncated += other.truncated;
+        keystrokes += other.keystrokes;
+        hits += other.hits;
+        keystroke_time += other.keystroke_time;
+        winners.insert(winners.end(), other.winners.begin(), other.winners.end());
+    }
+};
+
+// parse all sessions from [in, end), stops at the first malformed record
+static
+void score(std::string const& log, char const* in, char const* end, Stats& stats) {
+    Session session{log, 0, 0, 0, false};
+    size_t melody_size = 0;
+    bool started = false;
+
+    while(in != end) {
+        char tag = *in++;
+        std::uint64_t value;
+        if(not (in = record::decode_varint(in, end, value)))
+            break;
+
+        if(tag == record::START) {
+            std::uint64_t size;
+            if(not (in = record::decode_varint(in, end, size)) or size_t(end - in) < size)
+                break;
+            in += size;
+            if(started)
+                ++stats.truncated;
+            started = true;
+            session = Session{log, value, 0, 0, false};
+            melody_size = size;
+        }
+        else if(tag == record::KEYSTROKE and started) {
+            if(end - in < 2)
+                break;
+            in += 1; // the key itself is not needed for scoring
+            bool hit = *in++;
+            session.duration += value;
+            stats.keystrokes += 1;
+            stats.hits += hit;
+            stats.keystroke_time += value;
+        }
+        else if(tag == record::END and started) {
+            std::uint64_t count;
+            if(not (in = record::decode_varint(in, end, count)))
+                break;
+            session.duration += value;
+            session.count = count;
+            session.winner = count != 0 and count == melody_size;
+            stats.sessions += 1;
+            if(session.winner)
+                stats.winners.push_back(session);
+            started = false;
+        }
+        else
+            break;
+    }
+    if(started or in != end)
+        ++stats.truncated;
+}
+
+// map `log' in memory and score it
+static
+bool score(std::string const& log, Stats& stats) {
+    int fd = open(log.c_str(), O_RDONLY);
+    if(fd < 0)
+        return false;
+    struct stat st;
+    if(fstat(fd, &st)) {
+        close(fd);
+        return false;
+    }
+    // an empty log holds no session, and cannot be mapped
+    if(st.st_size == 0) {
+        close(fd);
+        return true;
+    }
+    void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(data == MAP_FAILED)
+        return false;
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+    char const* begin = static_cast<char const*>(data);
+    score(log, begin, begin + st.st_size, stats);
+    munmap(data, st.st_size);
+    return true;
+}
+
+static
+int usage(char const *progname) {
+    std::cerr << "usage: " << progname << " <log>..." << std::endl;
+    return 1;
+}
+
+int main(int argc, char * argv[]) {
+    if(argc < 2)
+        return usage(argv[0]);
+
+    std::vector<std::string> logs(argv + 1, argv + argc);
+
+    size_t nb_threads = std::max(1u, std::thread::hardware_concurrency());
+    nb_threads = std::min(nb_threads, logs.size());
+
+    // each worker grabs the next unprocessed log
+    std::atomic<size_t> next{0};
+    std::vector<Stats> stats(nb_threads);
+    std::vector<std::thread> workers;
+    for(size_t i = 0; i < nb_threads; ++i) {
+        workers.emplace_back([&logs, &next, &stats, i]() {
+            for(size_t j; (j = next++) < logs.size();) {
+                if(not score(logs[j], stats[i]))
+                    std::cerr << "failed to read session log " << logs[j] << std::endl;
+            }
+        });
+    }
+    for(std::thread& worker : workers)
+        worker.join();
+
+    Stats total;
+    for(Stats const& s : stats)
+        total.merge(s);
+
+    std::sort(total.winners.begin(), total.winners.end(),
+              [](Session const& a, Session const& b) { return a.duration < b.duration; });
+
+    std::cout << "--<< Leaderboard >>--" << std::endl;
+    size_t rank = 0;
+    for(Session const& session : total.winners) {
+        if(rank++ == 10)
+            break;
+        std::cout << std::setw(3) << rank << ". " << std::setw(8) << session.duration / 1000. << "ms  "
+                  << session.log << " @" << session.epoch << std::endl;
+    }
+
+    std::cout << "--<< Statistics >>--" << std::endl
+              << "sessions:   " << total.sessions << " (" << total.truncated << " truncated)" << std::endl
+              << "winners:    " << total.winners.size() << std::endl
+              << "keystrokes: " << total.keystrokes << " (" << total.hits << " hits)" << std::endl;
+    if(total.keystrokes)
+        std::cout << "mean time per keystroke: "
+                  << total.keystroke_time / 1000. / total.keystrokes << "ms" << std::endl;
+    return 0;
+}
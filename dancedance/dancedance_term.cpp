@@ -9,6 +9,7 @@ TermiOS::TermiOS() {
     if(tcgetattr(STDIN_FILENO, &_orig))
         std::cerr << "failed to get current mode" << std::endl;
     else {
+        _raw = _orig;
         cfmakeraw(&_raw);
         if(tcsetattr(STDIN_FILENO, TCSANOW, &_raw))
             std::cerr <<  "failed to use raw mode" << std::endl;
@@ -1,16 +1,20 @@
 #include "dancedance_term.hpp"
+#include "dancedance_record.hpp"
 
 #include <iostream>
 #include <string>
 #include <chrono>
 
 
-int main() {
+int main(int argc, char * argv[]) {
     std::cout << "--<< Dance Dance Fingers >>--" << std::endl;
 
     // melody to type with your finger
     const std::string melody = "ddfisfun";
 
+    // optional session log, see dancedance_record.hpp
+    Recorder recorder(argc > 1 ? argv[1] : "", melody);
+
     // game duration
     auto now = std::chrono::system_clock::now();
 
@@ -24,6 +28,7 @@ int main() {
             std::cout << note;
             char in;
             std::cin >> in;
+            recorder.keystroke(in, in == note);
             if(in != note) {
                 count = 0;
                 break;
@@ -33,6 +38,7 @@ int main() {
             }
         }
     }
+    recorder.end(count);
 
     // error handling
     if(count == 0) {
@@ -0,0 +1,191 @@
+/* MyLittlePocky
+ *   -- dices are magic
+ *
+ *
+ *                (( _______
+ *      _______     /\O    O\
+ *     /O     /\   /  \      \
+ *    /   O  /O \ / O  \O____O\ ))
+ * ((/_____O/    \\    /O     /
+ *   \O    O\    / \  /   O  /
+ *    \O    O\ O/   \/_____O/
+ *     \O____O\/ )) mrf      ))
+ *   ((
+ */
+
+#ifndef MYLITTLEPOCKY_HPP
+#define MYLITTLEPOCKY_HPP
+
+#include <random>
+#include <string>
+#include <iostream>
+#include <memory>
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// one engine shared by all dices, seeded on first use
+inline std::default_random_engine& RandomEngine() {
+  static std::default_random_engine engine{std::random_device()()};
+  return engine;
+}
+
+namespace details {
+template <size_t N> struct DiceName {
+  std::string operator()() const { return "d" + std::to_string(N); }
+};
+template <> struct DiceName<2> {
+  std::string operator()() const { return "coin"; }
+};
+constexpr size_t log2(size_t n) {
+  return n <= 1 ? 1 : (1 + log2(n >> 1));
+}
+
+constexpr size_t mlog(size_t n) {
+  return (log2(n) + 7) / 8;
+}
+
+}
+
+template<size_t N> struct small_container;
+
+template<> struct small_container<1> {
+  using type = std::uint8_t;
+};
+
+template<> struct small_container<2> {
+  using type = std::uint16_t;
+};
+
+template<> struct small_container<4> {
+  using type = std::uint32_t;
+};
+
+template<> struct small_container<8> {
+  using type = std::uint64_t;
+};
+
+template<size_t N>
+class D {
+  public:
+  typename small_container<details::mlog(N)>::type state_;
+
+  public:
+  D() { reroll(); }
+  unsigned value() const { return state_; }
+  void reroll() {
+    reroll(RandomEngine());
+  }
+  template<class Engine>
+  void reroll(Engine& engine) {
+    state_ = std::uniform_int_distribution<int>(1,N)(engine);
+  }
+  std::string name() const {
+    return details::DiceName<N>()();
+  }
+};
+
+using D6 = D<6>;
+using D20 = D<20>;
+using Coin = D<2>;
+
+template<class... Dices>
+class MyLittlePocky {
+  std::tuple<Dices...> pocket_;
+
+  public:
+
+  MyLittlePocky() = default;
+  explicit MyLittlePocky(Dices const&... dices) : pocket_(dices...) {}
+  std::tuple<Dices...> & pocket() { return pocket_; }
+  std::tuple<Dices...> const & pocket() const { return pocket_; }
+  // no begin / end
+
+};
+
+/* Tuple algorithms
+ *
+ * A pocket is a tuple, so these work on both. Each algorithm is a single pack
+ * expansion over the tuple indices instead of a recursion: a pocket of N dices
+ * costs one instantiation rather than N nested ones, the whole traversal can
+ * be inlined, and elements are always visited in order.
+ */
+
+namespace details {
+  template<class Tuple>
+  using indices_of = std::make_index_sequence<std::tuple_size<std::remove_const_t<Tuple>>::value>;
+
+  // braced lists are evaluated left to right, hence the expand arrays
+  template<class Op, class Tuple, size_t... Is>
+  void for_each(Op& op, Tuple& values, std::index_sequence<Is...>) {
+    int expand[] = {0, (void(op(std::get<Is>(values))), 0)...};
+    (void)expand;
+  }
+
+  template<class Op, class Tuple, size_t... Is>
+  auto transform(Op& op, Tuple& values, std::index_sequence<Is...>) {
+    return std::tuple<std::decay_t<decltype(op(std::get<Is>(values)))>...>{op(std::get<Is>(values))...};
+  }
+
+  template<class Op, class T, class Tuple, size_t... Is>
+  T reduce(Op& op, T init, Tuple& values, std::index_sequence<Is...>) {
+    int expand[] = {0, (void(init = op(std::move(init), std::get<Is>(values))), 0)...};
+    (void)expand;
+    return init;
+  }
+
+  // stops calling `pred' once the answer is known
+  template<class Pred, class Tuple, size_t... Is>
+  bool any(Pred& pred, Tuple& values, std::index_sequence<Is...>) {
+    bool found = false;
+    int expand[] = {0, (void(found = found or pred(std::get<Is>(values))), 0)...};
+    (void)expand;
+    return found;
+  }
+
+  struct Adder {
+    template<class T, class D>
+      T operator()(T total, D const& v) const {
+        return total + v.value();
+      }
+  };
+}
+
+// call op on each element
+template<class Op, class Tuple>
+void for_each(Op&& op, Tuple& values) {
+  details::for_each(op, values, details::indices_of<Tuple>{});
+}
+
+// a new tuple made of op applied to each element
+template<class Op, class Tuple>
+auto transform(Op&& op, Tuple& values) {
+  return details::transform(op, values, details::indices_of<Tuple>{});
+}
+
+// op(...op(op(init, first), second)..., last)
+template<class Op, class T, class Tuple>
+T reduce(Op&& op, T init, Tuple& values) {
+  return details::reduce(op, std::move(init), values, details::indices_of<Tuple>{});
+}
+
+// sum of the values of all dices
+template<class T = std::uint64_t, class Tuple>
+T sum(Tuple const& values) {
+  return reduce(details::Adder{}, T(0), values);
+}
+
+template<class Pred, class Tuple>
+bool any(Pred&& pred, Tuple& values) {
+  return details::any(pred, values, details::indices_of<Tuple>{});
+}
+
+template<class Pred, class Tuple>
+bool all(Pred&& pred, Tuple& values) {
+  auto fails = [&pred](auto& v) -> bool { return not pred(v); };
+  return not details::any(fails, values, details::indices_of<Tuple>{});
+}
+
+#endif
@@ -0,0 +1,77 @@
+/* Checks the dices against their exact odds with a chi-square test
+ */
+
+#include "mylittlepocky.hpp"
+#include "mylittlepocky_pool.hpp"
+#include "mylittlepocky_odds.hpp"
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+using MLP = MyLittlePocky<D6, D20, D6, Coin>;
+
+constexpr auto MLPOdds = exact_distribution<MLP>();
+static_assert(MLPOdds.size() == 35, "sums range from 0 to 34");
+static_assert(MLPOdds.total == 6 * 20 * 6 * 2, "every outcome is counted");
+static_assert(MLPOdds.counts[4] == 1 and MLPOdds.counts[34] == 1, "a single way to get the extremes");
+static_assert(exact_distribution<MyLittlePocky<D6, D6>>().counts[7] == 6, "the classic");
+
+struct Reroller {
+  template<class D>
+    void operator()(D& v) const {
+      v.reroll();
+    }
+};
+
+// chi-square statistic of `observed' against `expected' probabilities, bins
+// expecting less than 5 samples being merged with their neighbours
+static
+bool chi_square(char const* what, std::vector<size_t> const& observed,
+                std::vector<double> const& expected, size_t samples) {
+  double statistic = 0., bin_observed = 0., bin_expected = 0.;
+  size_t bins = 0;
+  for(size_t sum = 0; sum < expected.size(); ++sum) {
+    bin_observed += observed[sum];
+    bin_expected += expected[sum] * samples;
+    if(bin_expected >= 5. or sum + 1 == expected.size()) {
+      statistic += (bin_observed - bin_expected) * (bin_observed - bin_expected) / bin_expected;
+      bin_observed = bin_expected = 0.;
+      ++bins;
+    }
+  }
+
+  // critical value at p = 0.001, Wilson-Hilferty approximation
+  double const dof = bins - 1, z = 3.09;
+  double const critical = dof * std::pow(1. - 2. / (9. * dof) + z * std::sqrt(2. / (9. * dof)), 3);
+  bool const ok = statistic < critical;
+  std::cout << what << ": chi2 = " << statistic << " over " << dof << " degrees of freedom, critical "
+            << critical << (ok ? " ok" : " FAILED") << std::endl;
+  return ok;
+}
+
+int main(int argc, char* argv[]) {
+  size_t samples = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+  MLP pocket;
+  std::vector<size_t> observed(MLPOdds.size());
+  for(size_t i = 0; i < samples; ++i) {
+    for_each(Reroller{}, pocket.pocket());
+    ++observed[sum(pocket.pocket())];
+  }
+  std::vector<double> expected(MLPOdds.size());
+  for(size_t sum = 0; sum < expected.size(); ++sum)
+    expected[sum] = MLPOdds.probability(sum);
+  bool ok = chi_square("MyLittlePocky<D6, D20, D6, Coin>", observed, expected, samples);
+
+  DicePool<6> pool(100);
+  std::vector<double> pool_expected = sum_distribution(pool);
+  std::vector<size_t> pool_observed(pool_expected.size());
+  for(size_t i = 0; i < samples / 10; ++i) {
+    pool.reroll();
+    ++pool_observed[pool.sum()];
+  }
+  ok = chi_square("DicePool<6>(100)", pool_observed, pool_expected, samples / 10) and ok;
+
+  return ok ? 0 : 1;
+}
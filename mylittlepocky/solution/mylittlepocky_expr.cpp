@@ -0,0 +1,100 @@
+/* Dice expressions: compiled plans against a naive interpreter
+ */
+
+#include "mylittlepocky.hpp"
+#include "mylittlepocky_expr.hpp"
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+
+// what one would write first: walk the terms for every trial
+static
+long interpret(std::vector<DiceTerm> const& terms, std::default_random_engine& engine) {
+  long total = 0;
+  for(DiceTerm const& term : terms) {
+    if(not term.count) {
+      total += term.sign * term.constant;
+      continue;
+    }
+    std::vector<unsigned> rolls;
+    for(unsigned i = 0; i < term.count; ++i) {
+      std::uniform_int_distribution<unsigned> dice(1, term.faces);
+      unsigned roll = dice(engine), last = roll;
+      while(term.explode and last == term.faces)
+        roll += (last = dice(engine));
+      rolls.push_back(roll);
+    }
+    std::sort(rolls.begin(), rolls.end());
+    if(term.keep and not term.keep_lowest)
+      rolls.erase(rolls.begin(), rolls.end() - term.keep);
+    else if(term.keep)
+      rolls.resize(term.keep);
+    for(unsigned roll : rolls)
+      total += term.sign * long(roll);
+  }
+  return total;
+}
+
+template<class Evaluate>
+double measure(size_t trials, double& mean, Evaluate&& evaluate) {
+  auto start = std::chrono::steady_clock::now();
+  long long sum = evaluate();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  mean = double(sum) / trials;
+  return trials / elapsed.count() / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<std::string> expressions(argv + 1, argv + argc);
+  if(expressions.empty())
+    expressions = {"4d6kh3+d20", "3d6", "2d20kl1+5", "d6!", "10d10kh3-d4"};
+
+  size_t const trials = 10000000;
+  FastRoller roller{std::random_device()()};
+  std::default_random_engine engine{std::random_device()()};
+  std::vector<long> totals(trials);
+  bool ok = true;
+
+  for(std::string const& expression : expressions) {
+    DicePlan plan(expression);
+    std::vector<DiceTerm> const terms = parse_dice(expression);
+
+    double compiled_mean, naive_mean;
+    double compiled = measure(trials, compiled_mean, [&]() {
+      plan.run(roller, totals.data(), trials);
+      long long sum = 0;
+      for(long total : totals)
+        sum += total;
+      return sum;
+    });
+    double naive = measure(trials / 10, naive_mean, [&]() {
+      long long sum = 0;
+      for(size_t t = 0; t < trials / 10; ++t)
+        sum += interpret(terms, engine);
+      return sum;
+    });
+
+    bool const agree = std::abs(compiled_mean - naive_mean) < 0.01 * std::abs(naive_mean) + 0.05;
+    ok = ok and agree;
+    std::cout << expression << ":\tcompiled " << compiled << "M trials/s, naive " << naive
+              << "M trials/s (x" << compiled / naive << ")\tmean " << compiled_mean << " vs " << naive_mean
+              << (agree ? "" : " MISMATCH") << std::endl;
+  }
+
+  // the same first expression, as a type
+  Sum<KeepHighest<3, Roll<4, D6>>, Roll<1, D20>> typed;
+  double typed_mean;
+  double typed_speed = measure(trials / 10, typed_mean, [&]() {
+    long long sum = 0;
+    for(size_t t = 0; t < trials / 10; ++t)
+      sum += typed();
+    return sum;
+  });
+  std::cout << "Sum<KeepHighest<3, Roll<4, D6>>, Roll<1, D20>>:\t" << typed_speed
+            << "M trials/s\tmean " << typed_mean << " (expected 22.74)" << std::endl;
+  ok = ok and std::abs(typed_mean - 22.74) < 0.1;
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,263 @@
+#ifndef MYLITTLEPOCKY_EXPR_HPP
+#define MYLITTLEPOCKY_EXPR_HPP
+
+/* Dice expressions
+ *
+ * The usual notation: terms added or subtracted, each term being a constant
+ * or a roll `NdM' of N dices with M faces, optionally followed by
+ *
+ * - `khK' or `klK' to only keep the K highest or lowest dices,
+ * - `!' for exploding dices: a dice showing its maximum is rolled again and
+ *   added.
+ *
+ * For instance "4d6kh3+d20-2".
+ *
+ * A DicePlan parses an expression once, into a flat list of terms, and then
+ * evaluates it for whole batches of trials: each term fills a scratch buffer
+ * with the rolls of many trials at once, so there is no allocation nor
+ * interpretation per trial.
+ *
+ * The most common expressions can also be written as types, built from D<N>
+ * pockets and for_each, see Roll, KeepHighest, KeepLowest, Constant and Sum.
+ */
+
+#include "mylittlepocky.hpp"
+#include "mylittlepocky_roll.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct DiceTerm {
+  int sign = 1;
+  unsigned count = 0;       //< number of dices, 0 for a constant
+  unsigned faces = 0;
+  unsigned keep = 0;        //< number of dices kept, 0 to keep them all
+  bool keep_lowest = false;
+  bool explode = false;
+  long constant = 0;
+};
+
+// parse `expression' into its terms, raise std::invalid_argument on error
+inline std::vector<DiceTerm> parse_dice(std::string const& expression) {
+  std::vector<DiceTerm> terms;
+  size_t i = 0;
+  auto error = [&expression, &i](char const* what) {
+    return std::invalid_argument("invalid dice expression `" + expression + "' at "
+                                 + std::to_string(i) + ": " + what);
+  };
+  auto peek = [&expression, &i]() { return i < expression.size() ? expression[i] : '\0'; };
+  auto number = [&]() {
+    unsigned long value = 0;
+    if(not std::isdigit(static_cast<unsigned char>(peek())))
+      throw error("number expected");
+    while(std::isdigit(static_cast<unsigned char>(peek()))) {
+      value = value * 10 + (expression[i++] - '0');
+      if(value > 0xffffffffu)
+        throw error("number too large");
+    }
+    return unsigned(value);
+  };
+
+  int sign = 1;
+  for(;;) {
+    DiceTerm term;
+    term.sign = sign;
+    unsigned count = peek() == 'd' ? 1 : number();
+    if(peek() == 'd') {
+      ++i;
+      term.count = count;
+      term.faces = number();
+      if(term.count == 0 or term.faces == 0)
+        throw error("empty roll");
+      if(peek() == '!') {
+        ++i;
+        if(term.faces == 1)
+          throw error("a single faced dice cannot explode");
+        term.explode = true;
+      }
+      if(peek() == 'k') {
+        ++i;
+        if(peek() != 'h' and peek() != 'l')
+          throw error("`h' or `l' expected");
+        term.keep_lowest = expression[i++] == 'l';
+        term.keep = number();
+        if(term.keep == 0 or term.keep > term.count)
+          throw error("cannot keep that many dices");
+      }
+    }
+    else
+      term.constant = count;
+    terms.push_back(term);
+
+    if(peek() == '\0')
+      return terms;
+    if(peek() != '+' and peek() != '-')
+      throw error("`+' or `-' expected");
+    sign = expression[i++] == '+' ? 1 : -1;
+  }
+}
+
+class DicePlan {
+  std::vector<DiceTerm> rolls_;
+  long constant_ = 0;
+  unsigned widest_ = 0;   //< largest number of dices in a term
+
+  public:
+  static constexpr size_t batch = 4096;
+
+  explicit DicePlan(std::string const& expression) {
+    for(DiceTerm const& term : parse_dice(expression)) {
+      if(term.count) {
+        rolls_.push_back(term);
+        widest_ = std::max(widest_, term.count);
+      }
+      else
+        constant_ += term.sign * term.constant;
+    }
+  }
+
+  // evaluate the expression `trials' times
+  void run(FastRoller& roller, long* totals, size_t trials) const {
+    std::vector<std::uint32_t> scratch(batch * widest_);
+    for(size_t first = 0; first < trials; first += batch) {
+      size_t const size = trials - first < batch ? trials - first : batch;
+      long* const out = totals + first;
+      std::fill(out, out + size, constant_);
+      for(DiceTerm const& term : rolls_)
+        run(term, roller, scratch.data(), out, size);
+    }
+  }
+
+  private:
+  // add one term to a batch of trials
+  static void run(DiceTerm const& term, FastRoller& roller, std::uint32_t* rolls, long* out, size_t size) {
+    size_t const count = term.count;
+    roller.fill(term.faces, rolls, size * count);
+
+    if(term.explode) {
+      for(size_t r = 0; r < size * count; ++r)
+        for(std::uint32_t last = rolls[r]; last == term.faces;) {
+          last = roller.roll(term.faces);
+          rolls[r] += last;
+        }
+    }
+
+    if(term.keep and term.keep < count) {
+      for(size_t t = 0; t < size; ++t) {
+        std::uint32_t* first = rolls + t * count;
+        if(term.keep_lowest)
+          std::nth_element(first, first + term.keep, first + count);
+        else
+          std::nth_element(first, first + term.keep, first + count, std::greater<std::uint32_t>());
+        long sum = 0;
+        for(size_t k = 0; k < term.keep; ++k)
+          sum += first[k];
+        out[t] += term.sign * sum;
+      }
+    }
+    else {
+      for(size_t t = 0; t < size; ++t) {
+        long sum = 0;
+        for(size_t k = 0; k < count; ++k)
+          sum += rolls[t * count + k];
+        out[t] += term.sign * sum;
+      }
+    }
+  }
+};
+
+/* Compile-time expressions
+ *
+ *   using Stats = Sum<KeepHighest<3, Roll<4, D6>>>;   // 4d6kh3
+ *   using Attack = Sum<Roll<1, D20>, Constant<5>>;   // d20+5
+ *   Attack attack;
+ *   long damage = attack();
+ */
+
+namespace details {
+template<size_t, class T> using always = T;
+
+template<class Dice, class Indices> struct repeat;
+template<class Dice, size_t... Is>
+struct repeat<Dice, std::index_sequence<Is...>> {
+  using type = MyLittlePocky<always<Is, Dice>...>;
+};
+
+struct ValueCollector {
+  unsigned* out;
+  template<class D>
+    void operator()(D& v) {
+      v.reroll();
+      *out++ = v.value();
+    }
+};
+}
+
+// Count dices of the same kind, summed
+template<size_t Count, class Dice>
+class Roll {
+  protected:
+  typename details::repeat<Dice, std::make_index_sequence<Count>>::type pocket_;
+
+  // reroll every dice and collect their values
+  std::array<unsigned, Count> values() {
+    std::array<unsigned, Count> out;
+    for_each(details::ValueCollector{out.data()}, pocket_.pocket());
+    return out;
+  }
+
+  public:
+  long operator()() {
+    long sum = 0;
+    for(unsigned value : values())
+      sum += value;
+    return sum;
+  }
+};
+
+template<size_t Keep, size_t Count, class Dice, class Compare>
+class Keeper : Roll<Count, Dice> {
+  static_assert(Keep > 0 and Keep <= Count, "cannot keep that many dices");
+
+  public:
+  long operator()() {
+    auto values = this->values();
+    std::nth_element(values.begin(), values.begin() + Keep, values.end(), Compare());
+    long sum = 0;
+    for(size_t k = 0; k < Keep; ++k)
+      sum += values[k];
+    return sum;
+  }
+};
+
+template<size_t Keep, class R> class KeepHighest;
+template<size_t Keep, size_t Count, class Dice>
+class KeepHighest<Keep, Roll<Count, Dice>> : public Keeper<Keep, Count, Dice, std::greater<unsigned>> {};
+
+template<size_t Keep, class R> class KeepLowest;
+template<size_t Keep, size_t Count, class Dice>
+class KeepLowest<Keep, Roll<Count, Dice>> : public Keeper<Keep, Count, Dice, std::less<unsigned>> {};
+
+template<long Value>
+struct Constant {
+  long operator()() const { return Value; }
+};
+
+template<class... Terms>
+class Sum {
+  std::tuple<Terms...> terms_;
+
+  public:
+  long operator()() {
+    return reduce([](long total, auto& term) { return total + term(); }, 0L, terms_);
+  }
+};
+
+#endif
@@ -0,0 +1,97 @@
+/* Reproducible Monte Carlo study of a pocket
+ *
+ * Trial i draws from Philox(seed, i), whatever the thread running it, and
+ * threads only merge integer counts. The resulting distribution therefore
+ * only depends on the seed and the number of trials, never on the number of
+ * threads: the program checks it by running the same study with 1, 2, ...
+ * threads, reporting trials/s for each.
+ */
+
+#include "mylittlepocky.hpp"
+#include "mylittlepocky_odds.hpp"
+#include "mylittlepocky_philox.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <chrono>
+
+using MLP = MyLittlePocky<D6, D20, D6, Coin>;
+
+struct StreamReroller {
+  Philox& stream;
+  template<class D>
+    void operator()(D& v) const {
+      v.reroll(stream);
+    }
+};
+
+// number of trials reaching each sum
+template<class Pocket>
+std::vector<std::uint64_t> simulate(std::uint64_t seed, size_t trials, unsigned nb_threads, size_t size) {
+  std::vector<std::vector<std::uint64_t>> counts(nb_threads, std::vector<std::uint64_t>(size));
+  std::vector<std::thread> workers;
+  // building a pocket rolls its dices on the shared engine: do it once, here,
+  // and let each thread copy it, its values are rerolled from Philox anyway
+  Pocket const prototype;
+  for(unsigned t = 0; t < nb_threads; ++t) {
+    workers.emplace_back([&counts, &prototype, seed, trials, nb_threads, t]() {
+      Pocket pocket = prototype;
+      std::vector<std::uint64_t>& local = counts[t];
+      for(size_t i = trials * t / nb_threads; i < trials * (t + 1) / nb_threads; ++i) {
+        Philox stream(seed, i);
+        for_each(StreamReroller{stream}, pocket.pocket());
+        ++local[sum(pocket.pocket())];
+      }
+    });
+  }
+  for(std::thread& worker : workers)
+    worker.join();
+
+  std::vector<std::uint64_t> merged(size);
+  for(auto const& local : counts)
+    for(size_t sum = 0; sum < size; ++sum)
+      merged[sum] += local[sum];
+  return merged;
+}
+
+static
+int usage(char const *progname) {
+  std::cerr << "usage: " << progname << " <seed> <threads> <trials>" << std::endl;
+  return 1;
+}
+
+int main(int argc, char* argv[]) {
+  if(argc != 4)
+    return usage(argv[0]);
+  std::uint64_t seed = std::stoull(argv[1]);
+  int nb_threads = std::stoi(argv[2]);
+  long long trials = std::stoll(argv[3]);
+  if(nb_threads <= 0 or trials <= 0)
+    return usage(argv[0]);
+
+  constexpr auto odds = exact_distribution<MLP>();
+  std::vector<std::uint64_t> reference;
+  bool identical = true;
+
+  for(int n = 1; n <= nb_threads; ++n) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::uint64_t> counts = simulate<MLP>(seed, trials, n, odds.size());
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << n << " thread(s): " << trials / elapsed.count() / 1e6 << "M trials/s" << std::endl;
+    if(reference.empty())
+      reference = counts;
+    else if(counts != reference) {
+      std::cout << "\tresults differ from the single threaded run!" << std::endl;
+      identical = false;
+    }
+  }
+
+  std::cout << "sum\tobserved\texact" << std::endl << std::fixed << std::setprecision(6);
+  for(size_t sum = 0; sum < odds.size(); ++sum)
+    if(odds.counts[sum])
+      std::cout << sum << '\t' << double(reference[sum]) / trials << '\t' << odds.probability(sum) << std::endl;
+
+  return identical ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+#ifndef MYLITTLEPOCKY_ODDS_HPP
+#define MYLITTLEPOCKY_ODDS_HPP
+
+/* Exact odds of a pocket
+ *
+ * The sum of a pocket of dices follows the convolution of the uniform
+ * distributions of each dice. For a MyLittlePocky, whose dices are known at
+ * compile time, the number of ways to reach each sum is computed at compile
+ * time:
+ *
+ *   constexpr auto odds = exact_distribution<MyLittlePocky<D6, D20, D6, Coin>>();
+ *   static_assert(odds.counts[4] == 1, "all ones");
+ *
+ * Large pools would overflow these counts, so sum_distribution convolves
+ * probabilities at runtime instead, one dice at a time.
+ */
+
+#include "mylittlepocky.hpp"
+#include "mylittlepocky_pool.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// number of ways to reach each sum, out of `total' outcomes
+template<size_t Size>
+struct Distribution {
+  std::uint64_t counts[Size] = {};
+  std::uint64_t total = 1;
+
+  static constexpr size_t size() { return Size; }
+  constexpr double probability(size_t sum) const { return double(counts[sum]) / total; }
+};
+
+namespace details {
+constexpr size_t sum_of() { return 0; }
+template<class... Sizes>
+constexpr size_t sum_of(size_t n, Sizes... others) { return n + sum_of(others...); }
+
+template<size_t... Ns>
+constexpr Distribution<sum_of(Ns...) + 1> exact_distribution(MyLittlePocky<D<Ns>...> const*) {
+  constexpr size_t size = sum_of(Ns...) + 1;
+  size_t const faces[] = {Ns..., 0};
+  Distribution<size> odds;
+  odds.counts[0] = 1;
+  size_t highest = 0;
+  for(size_t i = 0; i < sizeof...(Ns); ++i) {
+    std::uint64_t next[size] = {};
+    for(size_t sum = 0; sum <= highest; ++sum)
+      for(size_t face = 1; face <= faces[i]; ++face)
+        next[sum + face] += odds.counts[sum];
+    highest += faces[i];
+    for(size_t sum = 0; sum <= highest; ++sum)
+      odds.counts[sum] = next[sum];
+    odds.total *= faces[i];
+  }
+  return odds;
+}
+}
+
+template<class Pocket>
+constexpr auto exact_distribution() {
+  return details::exact_distribution(static_cast<Pocket const*>(nullptr));
+}
+
+// probability of each sum of dices with the given number of faces
+inline std::vector<double> sum_distribution(std::vector<size_t> const& faces) {
+  std::vector<double> odds{1.};
+  for(size_t n : faces) {
+    // each new sum averages a sliding window of n previous sums
+    std::vector<double> next(odds.size() + n, 0.);
+    double window = 0.;
+    for(size_t sum = 1; sum < next.size(); ++sum) {
+      if(sum - 1 < odds.size())
+        window += odds[sum - 1];
+      if(sum > n)
+        window -= odds[sum - n - 1];
+      next[sum] = window / n;
+    }
+    odds.swap(next);
+  }
+  return odds;
+}
+
+template<size_t N>
+std::vector<double> sum_distribution(DicePool<N> const& pool) {
+  return sum_distribution(std::vector<size_t>(pool.size(), N));
+}
+
+#endif
@@ -0,0 +1,56 @@
+/* Memory taken by a pocket, as a tuple and packed
+ */
+
+#include "mylittlepocky.hpp"
+#include "mylittlepocky_packed.hpp"
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+
+using MLP = MyLittlePocky<D6, D20, D6, Coin>;
+using PLP = PackedPocky<D6, D20, D6, Coin>;
+
+static_assert(PLP::bits() == 3 + 5 + 3 + 1, "d6 need 3 bits, d20 5 bits and coins 1 bit");
+static_assert(sizeof(PLP) == 2, "12 bits fit in 2 bytes");
+static_assert(sizeof(PackedPocky<D<256>, D<256>, D<256>, D<256>, D<256>, D<256>, D<256>, D<256>, D<2>>) == 16,
+              "a dice never straddles two words");
+
+template<class Pocket, class Packed>
+void compare(char const* name) {
+  std::cout << name << ":\n\ttuple  " << sizeof(Pocket) << " bytes, "
+            << sizeof(Pocket) * 1000000 / 1024 << "kB per million pockets\n"
+            << "\tpacked " << sizeof(Packed) << " bytes (" << Packed::bits() << " bits), "
+            << sizeof(Packed) * 1000000 / 1024 << "kB per million pockets" << std::endl;
+}
+
+int main() {
+  compare<MLP, PLP>("MyLittlePocky<D6, D20, D6, Coin>");
+  compare<MyLittlePocky<D20, D20, D20, D20, D20, D20>, PackedPocky<D20, D20, D20, D20, D20, D20>>("6 x D20");
+  compare<MyLittlePocky<D<1000>, D<1000>, D<1000>, D6>, PackedPocky<D<1000>, D<1000>, D<1000>, D6>>("3 x D1000 + D6");
+  compare<MyLittlePocky<Coin, Coin, Coin, Coin, Coin, Coin, Coin, Coin>,
+          PackedPocky<Coin, Coin, Coin, Coin, Coin, Coin, Coin, Coin>>("8 coins");
+
+  // accessors round trip
+  PLP pocket;
+  pocket.set<0>(6);
+  pocket.set<1>(20);
+  pocket.set<2>(1);
+  pocket.set<3>(2);
+  bool ok = pocket.get<0>() == 6 and pocket.get<1>() == 20 and pocket.get<2>() == 1 and pocket.get<3>() == 2
+            and pocket.sum() == 29;
+
+  // and a million packed pockets rerolled
+  std::vector<PLP> pockets(1000000);
+  auto start = std::chrono::steady_clock::now();
+  unsigned long long total = 0;
+  for(PLP& p : pockets) {
+    p.reroll();
+    total += p.sum();
+    ok = ok and p.get<1>() >= 1 and p.get<1>() <= 20 and p.get<0>() <= 6 and p.get<3>() <= 2;
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << pockets.size() << " packed pockets rerolled in " << elapsed.count() * 1000
+            << "ms, mean sum " << double(total) / pockets.size() << " (expected 19)" << std::endl;
+  return ok ? 0 : 1;
+}
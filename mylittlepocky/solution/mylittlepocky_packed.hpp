@@ -0,0 +1,135 @@
+#ifndef MYLITTLEPOCKY_PACKED_HPP
+#define MYLITTLEPOCKY_PACKED_HPP
+
+/* A pocket packed down to the bit
+ *
+ * A D<N> needs ceil(log2(N)) bits to store its face, minus one, while the
+ * tuple of a MyLittlePocky gives each dice at least a byte. PackedPocky lays
+ * the dices out in the smallest integer able to hold them all, or in several
+ * 64-bit words for large pockets; a dice never straddles two words. The
+ * layout is computed at compile time, so accessors are a shift and a mask.
+ *
+ *   PackedPocky<D6, D20, D6, Coin> pocket; // 12 bits, stored in 2 bytes
+ *   pocket.get<1>();                       // the d20
+ */
+
+#include "mylittlepocky.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+
+namespace details {
+// bits needed to store 0..n-1
+constexpr size_t bits(size_t n) {
+  return n <= 1 ? 0 : 1 + bits((n + 1) / 2);
+}
+
+constexpr size_t word_bytes(size_t bits) {
+  return bits <= 8 ? 1 : bits <= 16 ? 2 : bits <= 32 ? 4 : 8;
+}
+
+// where each dice lives
+template<size_t... Ns>
+struct PackedLayout {
+  struct Slot {
+    size_t word, shift, bits;
+  };
+
+  static constexpr size_t total_bits() {
+    size_t const widths[] = {bits(Ns)..., 0};
+    size_t total = 0;
+    for(size_t width : widths)
+      total += width;
+    return total;
+  }
+
+  using word_type = typename small_container<word_bytes(total_bits())>::type;
+  static constexpr size_t word_bits = 8 * sizeof(word_type);
+
+  // dices are placed greedily, starting a new word when the current one is full
+  static constexpr Slot slot(size_t index) {
+    size_t const widths[] = {bits(Ns)..., 0};
+    Slot current{0, 0, widths[0]};
+    for(size_t i = 1; i <= index; ++i) {
+      current.shift += current.bits;
+      current.bits = widths[i];
+      if(current.shift + current.bits > word_bits) {
+        current.word += 1;
+        current.shift = 0;
+      }
+    }
+    return current;
+  }
+
+  static constexpr size_t words() {
+    return sizeof...(Ns) ? slot(sizeof...(Ns) - 1).word + 1 : 1;
+  }
+};
+}
+
+template<class... Dices> class PackedPocky;
+
+template<size_t... Ns>
+class PackedPocky<D<Ns>...> {
+  using layout = details::PackedLayout<Ns...>;
+  using word_type = typename layout::word_type;
+
+  static constexpr size_t faces(size_t index) {
+    size_t const all[] = {Ns..., 0};
+    return all[index];
+  }
+
+  word_type words_[layout::words()];
+
+  template<class Engine, size_t... Is>
+  void reroll(Engine& engine, std::index_sequence<Is...>) {
+    // every word is built in a register, then stored once
+    word_type next[layout::words()] = {};
+    int _[] = {0, (next[layout::slot(Is).word] |=
+                   word_type(std::uniform_int_distribution<unsigned>(0, Ns - 1)(engine))
+                   << layout::slot(Is).shift, 0)...};
+    (void)_;
+    std::copy(std::begin(next), std::end(next), std::begin(words_));
+  }
+
+  template<size_t... Is>
+  unsigned sum(std::index_sequence<Is...>) const {
+    unsigned total = 0;
+    int _[] = {0, (total += get<Is>(), 0)...};
+    (void)_;
+    return total;
+  }
+
+  public:
+
+  static constexpr size_t size() { return sizeof...(Ns); }
+  static constexpr size_t bits() { return layout::total_bits(); }
+
+  PackedPocky() { reroll(); }
+
+  // face of the I-th dice, from 1 to N
+  template<size_t I>
+  unsigned get() const {
+    constexpr auto slot = layout::slot(I);
+    constexpr std::uint64_t mask = (std::uint64_t(1) << slot.bits) - 1;
+    return unsigned((words_[slot.word] >> slot.shift) & mask) + 1;
+  }
+
+  template<size_t I>
+  void set(unsigned face) {
+    static_assert(I < sizeof...(Ns), "no such dice");
+    constexpr auto slot = layout::slot(I);
+    constexpr word_type mask = word_type(((std::uint64_t(1) << slot.bits) - 1) << slot.shift);
+    words_[slot.word] = (words_[slot.word] & ~mask) | (word_type(face - 1) << slot.shift);
+  }
+
+  void reroll() { reroll(RandomEngine()); }
+  template<class Engine>
+  void reroll(Engine& engine) { reroll(engine, std::index_sequence_for<D<Ns>...>{}); }
+
+  unsigned sum() const { return sum(std::index_sequence_for<D<Ns>...>{}); }
+};
+
+#endif
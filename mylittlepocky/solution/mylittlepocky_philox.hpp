@@ -0,0 +1,67 @@
+#ifndef MYLITTLEPOCKY_PHILOX_HPP
+#define MYLITTLEPOCKY_PHILOX_HPP
+
+/* Philox4x32-10, the counter-based generator of Salmon et al.
+ *
+ * Each output block is a pure function of a key and a counter, so a stream
+ * can be created anywhere, for instance one per Monte Carlo trial, without
+ * any shared state: the key holds the seed, the counter the stream number
+ * and the position in that stream.
+ *
+ * It models UniformRandomBitGenerator and can be used with the standard
+ * distributions, or with D<N>::reroll.
+ */
+
+#include <array>
+#include <cstdint>
+
+class Philox {
+  std::array<std::uint32_t, 4> counter_;
+  std::array<std::uint32_t, 2> key_;
+  std::array<std::uint32_t, 4> block_;
+  unsigned used_ = 4;
+
+  static std::array<std::uint32_t, 4> round(std::array<std::uint32_t, 4> const& c,
+                                           std::array<std::uint32_t, 2> const& k) {
+    std::uint64_t const p0 = std::uint64_t(0xD2511F53) * c[0];
+    std::uint64_t const p1 = std::uint64_t(0xCD9E8D57) * c[2];
+    return {{std::uint32_t(p1 >> 32) ^ c[1] ^ k[0], std::uint32_t(p1),
+             std::uint32_t(p0 >> 32) ^ c[3] ^ k[1], std::uint32_t(p0)}};
+  }
+
+  public:
+  using result_type = std::uint32_t;
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return ~result_type(0); }
+
+  Philox(std::uint64_t seed, std::uint64_t stream) :
+    counter_{{0, 0, std::uint32_t(stream), std::uint32_t(stream >> 32)}},
+    key_{{std::uint32_t(seed), std::uint32_t(seed >> 32)}}
+  {
+  }
+
+  // the ten rounds applied to a counter
+  static std::array<std::uint32_t, 4> block(std::array<std::uint32_t, 4> c,
+                                            std::array<std::uint32_t, 2> k) {
+    for(int r = 0; r < 10; ++r) {
+      if(r) {
+        k[0] += 0x9E3779B9;
+        k[1] += 0xBB67AE85;
+      }
+      c = round(c, k);
+    }
+    return c;
+  }
+
+  result_type operator()() {
+    if(used_ == 4) {
+      block_ = block(counter_, key_);
+      if(++counter_[0] == 0)
+        ++counter_[1];
+      used_ = 0;
+    }
+    return block_[used_++];
+  }
+};
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef MYLITTLEPOCKY_POOL_HPP
+#define MYLITTLEPOCKY_POOL_HPP
+
+/* A bag of identical dices
+ *
+ * MyLittlePocky needs one template argument per dice, which does not scale to
+ * a thousand d6. A DicePool<N> holds any number of N-sided dices, decided at
+ * runtime, and stores their states contiguously with the same width as a
+ * single D<N>. Operations are plain loops over that array, so that the
+ * compiler can vectorize them.
+ *
+ * A pool behaves like a big dice: its value is the sum of its dices, so it
+ * can be an element of a MyLittlePocky.
+ */
+
+#include "mylittlepocky.hpp"
+#include "mylittlepocky_roll.hpp"
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <atomic>
+
+namespace details {
+// seed of the i-th thread to get a roller: the i-th splitmix64 output after
+// a seed drawn once per process. RandomEngine is left alone, it is shared and
+// not thread-safe.
+inline std::uint64_t thread_seed() {
+  static std::uint64_t const base = std::uint64_t(std::random_device()()) << 32 | std::random_device()();
+  static std::atomic<std::uint64_t> threads{0};
+  std::uint64_t z = base + (threads.fetch_add(1, std::memory_order_relaxed) + 1) * 0x9e3779b97f4a7c15ull;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+// one fast roller per thread
+inline FastRoller& fast_roller() {
+  static thread_local FastRoller roller{thread_seed()};
+  return roller;
+}
+}
+
+template<size_t N>
+class DicePool {
+  public:
+  using state_type = typename small_container<details::mlog(N)>::type;
+
+  private:
+  std::vector<state_type> states_;
+
+  public:
+  explicit DicePool(size_t size = 0) : states_(size) { reroll(); }
+
+  size_t size() const { return states_.size(); }
+  state_type const* data() const { return states_.data(); }
+
+  void reroll() {
+    details::fast_roller().template fill<N>(states_.data(), states_.size());
+  }
+
+  // sum of all the dices
+  std::uint64_t sum() const {
+    std::uint64_t total = 0;
+    for(state_type state : states_)
+      total += state;
+    return total;
+  }
+
+  // number of dices showing each face, index 0 is always empty
+  std::vector<size_t> histogram() const {
+    std::vector<size_t> counts(N + 1);
+    for(state_type state : states_)
+      ++counts[state];
+    return counts;
+  }
+
+  // number of dices showing at least `threshold'
+  size_t count_at_least(unsigned threshold) const {
+    size_t count = 0;
+    for(state_type state : states_)
+      count += state >= threshold;
+    return count;
+  }
+
+  // dice interface, see D<N>
+  std::uint64_t value() const { return sum(); }
+  std::string name() const {
+    return std::to_string(size()) + details::DiceName<N>()();
+  }
+};
+
+#endif
@@ -0,0 +1,54 @@
+#include "mylittlepocky.hpp"
+#include "mylittlepocky_roll.hpp"
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <array>
+
+// rolls/s of `roll', called once for `count' rolls
+template<class Roll>
+double throughput(size_t count, Roll&& roll) {
+  auto start = std::chrono::steady_clock::now();
+  roll();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return count / elapsed.count();
+}
+
+template<size_t N>
+void compare(size_t count) {
+  using state_type = typename small_container<details::mlog(N)>::type;
+  std::vector<state_type> results(count);
+
+  D<N> dice;
+  double per_roll = throughput(count, [&]() {
+    for(auto& result : results) {
+      dice.reroll();
+      result = dice.state_;
+    }
+  });
+
+  FastRoller roller{std::random_device()()};
+  double bulk = throughput(count, [&]() { roller.fill<N>(results.data(), count); });
+
+  // a cheap sanity check, see the chi-square test for a real one
+  std::array<size_t, N + 1> histogram{};
+  for(auto result : results)
+    ++histogram[result];
+  bool ok = histogram[0] == 0;
+  for(size_t face = 1; face <= N; ++face)
+    ok = ok and histogram[face] > count / N * 9 / 10 and histogram[face] < count / N * 11 / 10;
+
+  std::cout << dice.name() << ":\tper roll " << per_roll / 1e6 << "M rolls/s"
+            << "\tbulk " << bulk / 1e6 << "M rolls/s"
+            << "\t(x" << bulk / per_roll << ")" << (ok ? "" : "\tSKEWED!") << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+  size_t count = argc > 1 ? std::stoul(argv[1]) : 100000000;
+  compare<2>(count);
+  compare<6>(count);
+  compare<20>(count);
+  compare<1000>(count);
+  return 0;
+}
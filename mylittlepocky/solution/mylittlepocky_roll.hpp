@@ -0,0 +1,166 @@
+#ifndef MYLITTLEPOCKY_ROLL_HPP
+#define MYLITTLEPOCKY_ROLL_HPP
+
+/* Rolling dices by the billion
+ *
+ * D<N>::reroll is fine for a pocket, but each roll goes through a fresh
+ * uniform_int_distribution and a shared engine. FastRoller instead runs
+ * several xoshiro128** streams side by side, one per lane, and turns each
+ * 32-bit output into a face with Lemire's nearly divisionless
+ * multiply-and-shift.
+ *
+ * Compilers do not find that vectorizing the lanes pays off, so with AVX2 the
+ * eight lanes of the default roller are stepped explicitly in one register
+ * per state word, the 32x32->64 products coming from _mm256_mul_epu32 on the
+ * even then the odd lanes. Other rollers, or targets without AVX2, step the
+ * lanes one after the other; both produce the same rolls.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+template<size_t Lanes = 8>
+class BasicFastRoller {
+  // state of each lane, stored word by word so that lanes are contiguous
+  std::uint32_t s0_[Lanes], s1_[Lanes], s2_[Lanes], s3_[Lanes];
+
+  static std::uint32_t rotl(std::uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+  // one xoshiro128** step for lane `l'
+  std::uint32_t next(size_t l) {
+    std::uint32_t const result = rotl(s1_[l] * 5, 7) * 9;
+    std::uint32_t const t = s1_[l] << 9;
+    s2_[l] ^= s0_[l];
+    s3_[l] ^= s1_[l];
+    s1_[l] ^= s2_[l];
+    s0_[l] ^= s3_[l];
+    s2_[l] ^= t;
+    s3_[l] = rotl(s3_[l], 11);
+    return result;
+  }
+
+  // a face of a n-sided dice from lane `l', with rejection
+  std::uint32_t face(size_t l, std::uint64_t m, std::uint32_t n) {
+    std::uint32_t const threshold = -n % n;
+    while(std::uint32_t(m) < threshold)
+      m = std::uint64_t(next(l)) * n;
+    return std::uint32_t(m >> 32) + 1;
+  }
+
+  // fill as many groups of Lanes rolls as possible, return how many rolls
+  template<class T, bool Vector>
+  size_t fill_vector(std::uint32_t, T*, size_t, std::integral_constant<bool, Vector>) {
+    return 0;
+  }
+
+#ifdef __AVX2__
+  static __m256i rotl(__m256i x, int k) {
+    return _mm256_or_si256(_mm256_slli_epi32(x, k), _mm256_srli_epi32(x, 32 - k));
+  }
+
+  template<class T>
+  size_t fill_vector(std::uint32_t n, T* out, size_t count, std::true_type) {
+    auto load = [](std::uint32_t const* s) { return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(s)); };
+    auto store = [](std::uint32_t* s, __m256i v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(s), v); };
+    __m256i s0 = load(s0_), s1 = load(s1_), s2 = load(s2_), s3 = load(s3_);
+    __m256i const faces = _mm256_set1_epi32(n);
+    __m256i const one = _mm256_set1_epi32(1);
+    std::uint32_t high[8], low[8];
+
+    size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+      // the same xoshiro128** step as next(), on all lanes
+      __m256i const x = rotl(_mm256_add_epi32(_mm256_slli_epi32(s1, 2), s1), 7);
+      __m256i const result = _mm256_add_epi32(_mm256_slli_epi32(x, 3), x);
+      __m256i const t = _mm256_slli_epi32(s1, 9);
+      s2 = _mm256_xor_si256(s2, s0);
+      s3 = _mm256_xor_si256(s3, s1);
+      s1 = _mm256_xor_si256(s1, s2);
+      s0 = _mm256_xor_si256(s0, s3);
+      s2 = _mm256_xor_si256(s2, t);
+      s3 = rotl(s3, 11);
+
+      // result * n, as 64-bit products of the even then the odd lanes, split
+      // back into their high halves (the faces) and low halves
+      __m256i const even = _mm256_mul_epu32(result, faces);
+      __m256i const odd = _mm256_mul_epu32(_mm256_srli_epi64(result, 32), faces);
+      __m256i const hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xaa);
+      __m256i const lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xaa);
+      store(high, _mm256_add_epi32(hi, one));
+
+      // a lane may need another draw when its low half is below n
+      __m256i const accepted = _mm256_cmpeq_epi32(_mm256_max_epu32(lo, faces), lo);
+      if(_mm256_movemask_ps(_mm256_castsi256_ps(accepted)) != 0xff) {
+        store(low, lo);
+        store(s0_, s0); store(s1_, s1); store(s2_, s2); store(s3_, s3);
+        for(size_t l = 0; l < 8; ++l)
+          high[l] = face(l, std::uint64_t(high[l] - 1) << 32 | low[l], n);
+        s0 = load(s0_); s1 = load(s1_); s2 = load(s2_); s3 = load(s3_);
+      }
+      for(size_t l = 0; l < 8; ++l)
+        out[i + l] = T(high[l]);
+    }
+    store(s0_, s0); store(s1_, s1); store(s2_, s2); store(s3_, s3);
+    return i;
+  }
+#endif
+
+  public:
+
+  // every lane gets its own splitmix64 derived seed
+  explicit BasicFastRoller(std::uint64_t seed) {
+    auto splitmix = [&seed]() {
+      std::uint64_t z = (seed += 0x9e3779b97f4a7c15);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+      return z ^ (z >> 31);
+    };
+    for(size_t l = 0; l < Lanes; ++l) {
+      std::uint64_t a = splitmix(), b = splitmix();
+      s0_[l] = a; s1_[l] = a >> 32; s2_[l] = b; s3_[l] = (b >> 32) | 1;
+    }
+  }
+
+  // fill [out, out + count) with rolls of a N-sided dice
+  template<size_t N, class T>
+  void fill(T* out, size_t count) {
+    static_assert(N > 0 and N <= 0xffffffffu, "faces must fit in 32 bits");
+    fill(std::uint32_t(N), out, count);
+  }
+
+  // same thing, with a number of faces only known at runtime
+  template<class T>
+  void fill(std::uint32_t n, T* out, size_t count) {
+    std::uint64_t m[Lanes];
+    size_t i = fill_vector(n, out, count, std::integral_constant<bool, Lanes == 8>{});
+    for(; i + Lanes <= count; i += Lanes) {
+      // the hot loop: all lanes step together and no lane branches
+      std::uint32_t low = ~std::uint32_t(0);
+      for(size_t l = 0; l < Lanes; ++l) {
+        m[l] = std::uint64_t(next(l)) * n;
+        out[i + l] = T(std::uint32_t(m[l] >> 32) + 1);
+        low = std::uint32_t(m[l]) < low ? std::uint32_t(m[l]) : low;
+      }
+      // a lane may need another draw, about n in 2^32 times
+      if(low < n)
+        for(size_t l = 0; l < Lanes; ++l)
+          out[i + l] = T(face(l, m[l], n));
+    }
+    for(size_t l = 0; i < count; ++i, ++l)
+      out[i] = T(face(l, std::uint64_t(next(l)) * n, n));
+  }
+
+  // a single roll of a n-sided dice
+  std::uint32_t roll(std::uint32_t n) {
+    return face(0, std::uint64_t(next(0)) * n, n);
+  }
+};
+
+using FastRoller = BasicFastRoller<>;
+
+#endif
@@ -0,0 +1,128 @@
+/* Traversing big pockets
+ *
+ * Rerolls and sums a pocket of DICES dices, with the tuple algorithms of
+ * mylittlepocky.hpp or, when built with -DRECURSIVE, with the recursive map
+ * they replaced, kept below for comparison. `make bench' builds it for
+ * several pocket sizes, timing each compilation too.
+ */
+
+#include "mylittlepocky.hpp"
+#include "mylittlepocky_expr.hpp"
+
+#include <iostream>
+#include <chrono>
+
+#ifndef DICES
+#define DICES 64
+#endif
+
+using Pocket = details::repeat<D6, std::make_index_sequence<DICES>>::type;
+
+// the former map: one instantiation per element, visited from last to first
+namespace recursive {
+  template<class Op, class T>
+  void map(Op&& , T& , std::integral_constant<size_t, 0>) {
+  }
+  template<class Op, class T, size_t N>
+  void map(Op&& op, T& values, std::integral_constant<size_t, N>) {
+    op(std::get<N-1>(values));
+    map(std::forward<Op>(op), values, std::integral_constant<size_t, N - 1>{});
+  }
+  template<class Op, class... Types>
+  void map(Op&& op, std::tuple<Types...>& values) {
+    map(std::forward<Op>(op), values, std::integral_constant<size_t, sizeof...(Types)>{});
+  }
+}
+
+// xorshift64, cheap enough not to hide the traversal
+struct Engine {
+  using result_type = std::uint64_t;
+  std::uint64_t state = 0x9e3779b97f4a7c15;
+  static constexpr result_type min() { return 1; }
+  static constexpr result_type max() { return ~result_type(0); }
+  result_type operator()() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+};
+
+struct Reroller {
+  Engine& engine;
+  template<class D>
+    void operator()(D& v) const {
+      v.reroll(engine);
+    }
+};
+
+struct Summer {
+  std::uint64_t& total;
+  template<class D>
+    void operator()(D const& v) const {
+      total += v.value();
+    }
+};
+
+static
+void reroll(Pocket& pocket, Engine& engine) {
+#ifdef RECURSIVE
+  recursive::map(Reroller{engine}, pocket.pocket());
+#else
+  for_each(Reroller{engine}, pocket.pocket());
+#endif
+}
+
+static
+std::uint64_t total(Pocket& pocket) {
+#ifdef RECURSIVE
+  std::uint64_t result = 0;
+  recursive::map(Summer{result}, pocket.pocket());
+  return result;
+#else
+  return sum(pocket.pocket());
+#endif
+}
+
+// as far as the compiler knows, every dice may have changed: the sum of the
+// pocket cannot be hoisted out of the loop
+static
+void clobber(Pocket& pocket) {
+  asm volatile("" : : "r"(&pocket) : "memory");
+}
+
+template<class F>
+void measure(char const* what, size_t rounds, F&& f) {
+  auto start = std::chrono::steady_clock::now();
+  std::uint64_t checksum = 0;
+  for(size_t i = 0; i < rounds; ++i)
+    checksum += f(i);
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "  " << what << ": " << elapsed.count() * 1e9 / rounds << "ns/pocket, "
+            << double(rounds) * DICES / elapsed.count() / 1e6 << "M dices/s (checksum "
+            << checksum << ")" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+  size_t const dices = size_t(1) << 26;
+  size_t const rounds = argc > 1 ? std::stoul(argv[1]) : dices / DICES;
+
+  Pocket pocket;
+  Engine engine;
+#ifdef RECURSIVE
+  std::cout << "recursive map, ";
+#else
+  std::cout << "pack expansion, ";
+#endif
+  std::cout << DICES << " dices, " << rounds << " rounds" << std::endl;
+
+  measure("reroll", rounds, [&](size_t) {
+    reroll(pocket, engine);
+    return std::get<DICES - 1>(pocket.pocket()).value();
+  });
+  measure("sum", rounds, [&](size_t) {
+    clobber(pocket);
+    return total(pocket);
+  });
+  return 0;
+}
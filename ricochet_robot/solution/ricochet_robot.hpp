@@ -0,0 +1,347 @@
+#ifndef RICOCHET_ROBOT_HPP
+#define RICOCHET_ROBOT_HPP
+
+#include <array>
+#include <sstream>
+#include <iostream>
+#include <fstream>
+#include <cassert>
+#include <string>
+#include <limits>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/* Base class for all tiles
+ *
+ * Implements the default behavior of a tile, i.e. an empty tile
+ */
+struct Tile {
+  virtual char str() const = 0;
+  virtual bool blocks() const { return false; }
+  virtual bool wins() const { return false;}
+};
+
+/* Regular empty tile
+ */
+struct Empty : Tile {
+  static constexpr char value = ' ';
+  virtual char str() const override { return value; }
+};
+
+/* A blocking tile
+ */
+struct Wall : Tile {
+  static constexpr char value = '#';
+  virtual char str() const override { return value; }
+  virtual bool blocks() const override { return true; }
+};
+
+/* Borders are blocking tiles with a different rendering
+ */
+struct Border : Wall {
+  static constexpr char value = '@';
+  virtual char str() const override { return value; }
+};
+
+/* Exit tile are non blocking (you must stop on them)
+ * they make you win!
+ */
+struct Exit : Empty {
+  static constexpr char value = 'O';
+  virtual char str() const override { return value; }
+  virtual bool wins() const override { return true;}
+};
+
+/* An entrance tile is very special: there can be only one, a property enforced
+ * by its singleton design
+ */
+struct Entrance : Empty {
+
+  static constexpr char value = 'I';
+  virtual char str() const override { return value; }
+  static Entrance &get() {
+    static Entrance singleton;
+    return singleton;
+  }
+
+  private:
+    Entrance() = default;
+};
+
+/* lightweight factory of tile: all tiles have no state anyway
+ */
+inline Tile *make_tile(char code) {
+  static Empty empty;
+  static Wall wall;
+  static Exit exit;
+  static Border border;
+  switch (code) {
+  case Empty::value:
+    return &empty;
+  case Wall::value:
+    return &wall;
+  case Entrance::value:
+    return &Entrance::get();
+  case Exit::value:
+    return &exit;
+  case Border::value:
+    return &border;
+  default:
+    throw std::domain_error("invalid tile specification");
+  }
+}
+
+/* The characters of a board file
+ *
+ * The file is mapped rather than read, or read at once when it cannot be
+ * mapped. A single scan then finds the start of every row, checks that they
+ * all have the same length and counts the entrances: 16 characters at a time
+ * when SSE2 is available, newlines being located through the bits of a
+ * comparison mask. Lines may end with "\r\n", trailing empty lines are
+ * ignored.
+ */
+class BoardFile {
+  public:
+
+  static constexpr size_t max_size = 4096;
+
+  explicit BoardFile(std::string const& rc) {
+    int fd = open(rc.c_str(), O_RDONLY);
+    struct stat st;
+    if(fd >= 0 and not fstat(fd, &st) and S_ISREG(st.st_mode) and st.st_size > 0) {
+      void* mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if(mapping != MAP_FAILED) {
+        data_ = static_cast<char const*>(mapping);
+        size_ = st.st_size;
+        mapped_ = true;
+      }
+    }
+    if(fd >= 0)
+      close(fd);
+
+    if(not mapped_) {
+      std::ifstream ifs(rc.c_str());
+      if(not ifs)
+        throw std::runtime_error("invalid resource: " + rc);
+      buffer_ = std::string{std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+      data_ = buffer_.data();
+      size_ = buffer_.size();
+    }
+
+    // the destructor won't run if we raise from here
+    try {
+      scan();
+    }
+    catch(...) {
+      if(mapped_)
+        munmap(const_cast<char*>(data_), size_);
+      throw;
+    }
+  }
+
+  ~BoardFile() {
+    if(mapped_)
+      munmap(const_cast<char*>(data_), size_);
+  }
+
+  BoardFile(BoardFile const&) = delete;
+  BoardFile& operator=(BoardFile const&) = delete;
+
+  size_t height() const { return rows_.size(); }
+  size_t width() const { return width_; }
+  char const* row(size_t i) const { return data_ + rows_[i]; }
+
+  private:
+
+  void scan() {
+    size_t size = size_;
+    while(size and (data_[size - 1] == '\n' or data_[size - 1] == '\r'))
+      --size;
+    if(not size)
+      throw std::runtime_error("invalid grid: empty");
+
+    size_t entrances = 0;
+    size_t i = 0;
+#ifdef __SSE2__
+    __m128i const newline = _mm_set1_epi8('\n');
+    __m128i const entrance = _mm_set1_epi8(Entrance::value);
+    for(; i + 16 <= size; i += 16) {
+      __m128i chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data_ + i));
+      entrances += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, entrance)));
+      for(unsigned newlines = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline)); newlines; newlines &= newlines - 1)
+        end_row(i + __builtin_ctz(newlines));
+    }
+#endif
+    for(; i < size; ++i) {
+      entrances += data_[i] == Entrance::value;
+      if(data_[i] == '\n')
+        end_row(i);
+    }
+    end_row(size);
+
+    if(entrances == 0)
+      throw std::runtime_error("invalid grid no entrance");
+    if(entrances > 1)
+      throw std::runtime_error("invalid grid: several entrances");
+  }
+
+  // the current row ends at eol
+  void end_row(size_t eol) {
+    size_t const start = next_row_;
+    size_t length = eol - start;
+    if(length and data_[eol - 1] == '\r')
+      --length;
+    if(rows_.empty()) {
+      if(length == 0 or length > max_size)
+        throw std::runtime_error("invalid grid size: " + std::to_string(length) + " columns");
+      width_ = length;
+    }
+    else if(length != width_)
+      throw std::runtime_error("invalid grid size: line " + std::to_string(rows_.size() + 1) + " has " +
+                               std::to_string(length) + " columns instead of " + std::to_string(width_));
+    if(rows_.size() == max_size)
+      throw std::runtime_error("invalid grid size: more than " + std::to_string(max_size) + " lines");
+    rows_.push_back(start);
+    next_row_ = eol + 1;
+  }
+
+  char const* data_ = nullptr;
+  size_t size_ = 0;
+  bool mapped_ = false;
+  std::string buffer_;
+
+  std::vector<size_t> rows_;  // offset of each row in data_
+  size_t width_ = 0;
+  size_t next_row_ = 0;
+};
+
+/* Cells are stored row by row, surrounded by borders
+ */
+struct Board {
+  Board(std::string const& rc) : Board(BoardFile(rc)) {
+  }
+
+  explicit Board(BoardFile const& file) :
+    height_(file.height()),
+    width_(file.width()),
+    board_(stride() * (height_ + 2), make_tile(Border::value))
+  {
+    for(size_t i = 0; i < height_; ++i)
+      std::transform(file.row(i), file.row(i) + width_, begin() + (i + 1) * stride() + 1, make_tile);
+    entrance_ = std::find(begin(), end(), &Entrance::get()) - begin();
+  }
+
+  size_t height() const { return height_; }
+  size_t width() const { return width_; }
+  size_t stride() const { return width_ + 2; }
+
+  bool run(std::string const& commands) const {
+    const_iterator curr_pos = begin() + entrance_;
+    for(char command : commands)
+      slide(curr_pos, command);
+    return (*curr_pos)->wins();
+  }
+
+  /* Cells are numbered row by row, borders included
+   */
+  size_t size() const { return end() - begin(); }
+  size_t entrance() const { return entrance_; }
+  bool wins(size_t cell) const { return begin()[cell]->wins(); }
+  bool blocks(size_t cell) const { return begin()[cell]->blocks(); }
+  Tile const& tile(size_t cell) const { return *begin()[cell]; }
+
+  // the cell where the robot stops when moved from cell, which must not block
+  size_t slide(size_t cell, char command) const {
+    assert(not blocks(cell) && "the robot cannot stand on a blocking cell");
+    const_iterator pos = begin() + cell;
+    slide(pos, command);
+    return pos - begin();
+  }
+
+  std::string str() const {
+    std::string out;
+    auto out_iter = std::back_inserter(out);
+    for(const_iterator line = begin(); line != end(); line += stride()) {
+      *std::transform(line, line + stride(), out_iter,
+                      [](Tile *const tile) { return tile->str(); })++ = '\n';
+    }
+    return out;
+  }
+
+
+  private:
+
+  using iterator = Tile * *;
+  using const_iterator = Tile * const*;
+
+  iterator begin() { return board_.data(); }
+  iterator end() { return begin() + board_.size(); }
+  const_iterator begin() const { return board_.data(); }
+  const_iterator end() const { return begin() + board_.size(); }
+
+  void slide(const_iterator& curr_pos, char command) const {
+    switch(command) {
+      case 'h':
+        slideLeft(curr_pos);
+        break;
+      case 'j':
+        slideDown(curr_pos);
+        break;
+      case 'k':
+        slideUp(curr_pos);
+        break;
+      case 'l':
+        slideRight(curr_pos);
+        break;
+      default:
+        throw std::runtime_error("invalid command");
+    }
+  }
+
+  void slideLeft(const_iterator& curr_pos) const;
+  void slideRight(const_iterator& curr_pos) const;
+  void slideUp(const_iterator& curr_pos) const;
+  void slideDown(const_iterator& curr_pos) const;
+
+  size_t height_;
+  size_t width_;
+  std::vector<Tile*> board_;
+  size_t entrance_;
+
+};
+
+inline void Board::slideLeft(const_iterator& curr_pos) const {
+  while(not (*curr_pos)->blocks())
+    curr_pos -= 1;
+  curr_pos += 1;
+}
+inline void Board::slideRight(const_iterator& curr_pos) const {
+  while(not (*curr_pos)->blocks())
+    curr_pos += 1;
+  curr_pos -= 1;
+}
+
+inline void Board::slideDown(const_iterator& curr_pos) const {
+  while(not (*curr_pos)->blocks())
+    curr_pos += stride();
+  curr_pos -= stride();
+}
+
+inline void Board::slideUp(const_iterator& curr_pos) const {
+  while(not (*curr_pos)->blocks())
+    curr_pos -= stride();
+  curr_pos += stride();
+}
+
+#endif
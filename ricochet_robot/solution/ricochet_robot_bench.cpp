@@ -0,0 +1,122 @@
+/* Tiles, bytes or bits?
+ *
+ * Runs the same random sequences of commands on a Board, on the Grid built
+ * from it walking cell by cell, and on the Grid using its bitsets, reporting
+ * runs/s and slides/s for each, after checking that all three render and stop
+ * the robot at the same places.
+ *
+ * With -g, writes a random board instead, with the given proportion of
+ * walls, to compare sparse and dense boards.
+ */
+
+#include "ricochet_robot.hpp"
+#include "ricochet_robot_grid.hpp"
+
+#include <iostream>
+#include <random>
+#include <vector>
+#include <chrono>
+#include <cstring>
+
+template<class Run>
+void measure(char const* what, std::vector<std::string> const& sequences, size_t rounds, Run&& run) {
+  size_t wins = 0;
+  auto start = std::chrono::steady_clock::now();
+  for(size_t r = 0; r < rounds; ++r)
+    for(std::string const& commands : sequences)
+      wins += run(commands);
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  double runs = double(rounds) * sequences.size();
+  std::cout << "  " << what << ": " << runs / elapsed.count() / 1e6 << "M runs/s, "
+            << runs * sequences[0].size() / elapsed.count() / 1e6 << "M slides/s ("
+            << wins << " wins)" << std::endl;
+}
+
+static
+int generate(size_t height, size_t width, double density, unsigned seed) {
+  std::mt19937 rengine(seed);
+  std::bernoulli_distribution wall(density);
+  std::string board;
+  board.reserve((width + 1) * height);
+  for(size_t i = 0; i < height; ++i) {
+    for(size_t j = 0; j < width; ++j)
+      board.push_back(wall(rengine) ? Wall::value : Empty::value);
+    board.push_back('\n');
+  }
+  std::uniform_int_distribution<size_t> row(0, height - 1), column(0, width - 1);
+  board[row(rengine) * (width + 1) + column(rengine)] = Entrance::value;
+  for(size_t e = 0; e < 16; ++e) {
+    char& exit = board[row(rengine) * (width + 1) + column(rengine)];
+    if(exit != Entrance::value)
+      exit = Exit::value;
+  }
+  std::cout << board;
+  return std::cout ? 0 : 1;
+}
+
+static
+int usage(char const *progname) {
+  std::cerr << "usage: " << progname << " [map] [rounds]" << std::endl
+            << "       " << progname << " -g <height> <width> <wall density> <seed>" << std::endl;
+  return 1;
+}
+
+int main(int argc, char* argv[]) {
+  if(argc > 1 and std::strcmp(argv[1], "-g") == 0) {
+    if(argc != 6)
+      return usage(argv[0]);
+    return generate(std::stoul(argv[2]), std::stoul(argv[3]), std::stod(argv[4]), std::stoul(argv[5]));
+  }
+  if(argc > 3)
+    return usage(argv[0]);
+
+  std::string map = argc > 1 ? argv[1] : "default.txt";
+  size_t const rounds = argc > 2 ? std::stoul(argv[2]) : 100;
+  size_t const nb_sequences = 1 << 12,
+               length = 32;
+
+  Board board{map};
+  Grid grid{board};
+  if(grid.str() != board.str()) {
+    std::cerr << "the grid does not render as the board!" << std::endl;
+    return 1;
+  }
+
+  std::mt19937 rengine(42);
+  std::uniform_int_distribution<int> dist(0, 3);
+  std::vector<std::string> sequences(nb_sequences, std::string(length, ' '));
+  for(std::string& commands : sequences)
+    for(char& c : commands)
+      c = "hjkl"[dist(rengine)];
+
+  for(std::string const& commands : sequences) {
+    size_t by_board = board.entrance(),
+           by_walk = grid.entrance(),
+           by_bits = grid.entrance();
+    for(char command : commands) {
+      by_board = board.slide(by_board, command);
+      by_walk = grid.walk(by_walk, command);
+      by_bits = grid.slide(by_bits, command);
+      if(by_walk != by_board or by_bits != by_board) {
+        std::cerr << "the grid and the board disagree!" << std::endl;
+        return 1;
+      }
+    }
+  }
+
+  std::cout << map << ", " << board.height() << "x" << board.width() << ", "
+            << sizeof(Tile*) << " bytes per tile cell, " << sizeof(std::uint8_t) << " per grid cell" << std::endl;
+  measure("board", sequences, rounds, [&board](std::string const& commands) {
+    return board.run(commands);
+  });
+  measure("grid, walking", sequences, rounds, [&grid](std::string const& commands) {
+    size_t pos = grid.entrance();
+    for(char command : commands)
+      pos = grid.walk(pos, command);
+    return grid.wins(pos);
+  });
+  measure("grid, bitsets", sequences, rounds, [&grid](std::string const& commands) {
+    return grid.run(commands);
+  });
+  return 0;
+}
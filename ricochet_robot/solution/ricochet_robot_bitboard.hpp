@@ -0,0 +1,67 @@
+#ifndef RICOCHET_ROBOT_BITBOARD_HPP
+#define RICOCHET_ROBOT_BITBOARD_HPP
+
+/* Where does the robot stop?
+ *
+ * Blockers keeps one bitset per line of the board (a row or a column), bit
+ * p being set when the cell at position p of that line blocks the robot.
+ * The robot sliding from p stops right before the next set bit, found by
+ * masking the bits on the wrong side of p then counting trailing (or
+ * leading) zeros; the following words are only inspected when a whole word
+ * is empty, which is 64 free cells at once. Searches stop at the ends of the
+ * line: from a free cell, borders guarantee a set bit on both sides, but a
+ * border cell itself has none beyond it.
+ */
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class Blockers {
+  public:
+
+  Blockers(size_t lines, size_t length) :
+    words_((length + 63) / 64),
+    bits_(lines * words_)
+  {
+  }
+
+  void set(size_t line, size_t pos) {
+    bits_[line * words_ + pos / 64] |= std::uint64_t(1) << (pos % 64);
+  }
+
+  static constexpr size_t none = ~size_t(0);
+
+  // position of the first blocking cell after pos, none if there is none
+  size_t next(size_t line, size_t pos) const {
+    std::uint64_t const* words = &bits_[line * words_];
+    size_t i = pos / 64;
+    std::uint64_t word = words[i] & (~std::uint64_t(1) << (pos % 64));
+    while(not word) {
+      if(++i == words_)
+        return none;
+      word = words[i];
+    }
+    return i * 64 + __builtin_ctzll(word);
+  }
+
+  // position of the last blocking cell before pos, none if there is none
+  size_t previous(size_t line, size_t pos) const {
+    std::uint64_t const* words = &bits_[line * words_];
+    size_t i = pos / 64;
+    std::uint64_t word = words[i] & ((std::uint64_t(1) << (pos % 64)) - 1);
+    while(not word) {
+      if(i-- == 0)
+        return none;
+      word = words[i];
+    }
+    return i * 64 + 63 - __builtin_clzll(word);
+  }
+
+  private:
+
+  size_t words_;
+  std::vector<std::uint64_t> bits_;
+};
+
+#endif
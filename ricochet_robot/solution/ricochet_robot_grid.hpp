@@ -0,0 +1,147 @@
+#ifndef RICOCHET_ROBOT_GRID_HPP
+#define RICOCHET_ROBOT_GRID_HPP
+
+/* A board made of bytes
+ *
+ * Board holds a Tile pointer per cell and asks each tile, through a virtual
+ * call, whether it blocks the robot. Grid keeps the same cells, numbered the
+ * same way, as one byte of properties each: sliding reads consecutive bytes
+ * (or bytes a row apart) and tests a bit. Tiles remain the way to read and
+ * describe boards, Grid is built from a Board and renders itself through a
+ * table indexed by the properties.
+ *
+ * Blocking cells are also recorded in a bitset per row and per column, so
+ * that slide and run find where the robot stops without visiting the cells
+ * in between, see Blockers. walk still goes cell by cell.
+ */
+
+#include "ricochet_robot.hpp"
+#include "ricochet_robot_bitboard.hpp"
+
+#include <vector>
+#include <cstdint>
+
+namespace cell {
+  constexpr std::uint8_t Blocking = 1;
+  constexpr std::uint8_t Winning = 2;
+  constexpr std::uint8_t Entrance = 4;
+  constexpr std::uint8_t Border = 8;    // only changes the rendering
+}
+
+class Grid {
+  public:
+
+  explicit Grid(Board const& board) :
+    cells_(board.size()),
+    stride_(board.stride()),
+    entrance_(board.entrance()),
+    rows_(board.size() / stride_, stride_),
+    columns_(stride_, board.size() / stride_)
+  {
+    for(size_t c = 0; c < cells_.size(); ++c) {
+      Tile const& tile = board.tile(c);
+      cells_[c] = (tile.blocks() ? cell::Blocking : 0) |
+                  (tile.wins() ? cell::Winning : 0) |
+                  (&tile == &Entrance::get() ? cell::Entrance : 0) |
+                  (dynamic_cast<Border const*>(&tile) ? cell::Border : 0);
+      if(tile.blocks()) {
+        rows_.set(c / stride_, c % stride_);
+        columns_.set(c % stride_, c / stride_);
+      }
+    }
+  }
+
+  // the robot position is tracked as a row and a column, to save divisions
+  bool run(std::string const& commands) const {
+    size_t row = entrance_ / stride_,
+           column = entrance_ % stride_;
+    for(char command : commands)
+      slide(row, column, command);
+    return wins(row * stride_ + column);
+  }
+
+  size_t size() const { return cells_.size(); }
+  size_t stride() const { return stride_; }
+  bool blocks(size_t c) const { return cells_[c] & cell::Blocking; }
+  size_t entrance() const { return entrance_; }
+  bool wins(size_t c) const { return cells_[c] & cell::Winning; }
+
+  // the cell where the robot stops when moved from c, which must not block
+  size_t slide(size_t c, char command) const {
+    assert(not blocks(c) && "the robot cannot stand on a blocking cell");
+    size_t row = c / stride_,
+           column = c % stride_;
+    slide(row, column, command);
+    return row * stride_ + column;
+  }
+
+  // the same, one cell at a time
+  size_t walk(size_t c, char command) const {
+    assert(not blocks(c) && "the robot cannot stand on a blocking cell");
+    switch(command) {
+      case 'h':
+        return slide_by(c, -1);
+      case 'j':
+        return slide_by(c, stride_);
+      case 'k':
+        return slide_by(c, -std::ptrdiff_t(stride_));
+      case 'l':
+        return slide_by(c, 1);
+      default:
+        throw std::runtime_error("invalid command");
+    }
+  }
+
+  std::string str() const {
+    std::string out;
+    for(size_t c = 0; c < cells_.size(); ++c) {
+      out.push_back(render(cells_[c]));
+      if(c % stride_ == stride_ - 1)
+        out.push_back('\n');
+    }
+    return out;
+  }
+
+  private:
+
+  void slide(size_t& row, size_t& column, char command) const {
+    switch(command) {
+      case 'h':
+        column = rows_.previous(row, column) + 1;
+        break;
+      case 'j':
+        row = columns_.next(column, row) - 1;
+        break;
+      case 'k':
+        row = columns_.previous(column, row) + 1;
+        break;
+      case 'l':
+        column = rows_.next(row, column) - 1;
+        break;
+      default:
+        throw std::runtime_error("invalid command");
+    }
+  }
+
+  size_t slide_by(size_t c, std::ptrdiff_t step) const {
+    while(not (cells_[c] & cell::Blocking))
+      c += step;
+    return c - step;
+  }
+
+  static char render(std::uint8_t properties) {
+    static constexpr char chars[] = {
+      Empty::value, Wall::value, Exit::value, '?', Entrance::value, '?', '?', '?',
+      '?', Border::value, '?', '?', '?', '?', '?', '?'
+    };
+    return chars[properties];
+  }
+
+  std::vector<std::uint8_t> cells_;
+  size_t stride_;
+  size_t entrance_;
+  Blockers rows_;
+  Blockers columns_;
+};
+
+#endif
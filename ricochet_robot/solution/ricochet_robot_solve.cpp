@@ -0,0 +1,65 @@
+/* Solve boards
+ *
+ * Prints the shortest way out of each board given on the command line, then
+ * checks it against Board::run, along with every shorter sequence of
+ * commands when there are not too many of them: none of those may win.
+ * Solving the Grid of the board must give a way out as short.
+ */
+
+#include "ricochet_robot.hpp"
+#include "ricochet_robot_solver.hpp"
+#include "ricochet_robot_grid.hpp"
+
+#include <iostream>
+
+// every sequence of length commands, in place
+static
+bool next_sequence(std::string& commands) {
+  for(char& c : commands) {
+    size_t i = std::string("hjkl").find(c);
+    if(i + 1 < Solver::NbCommands) {
+      c = Solver::command(i + 1);
+      return true;
+    }
+    c = Solver::command(0);
+  }
+  return false;
+}
+
+static
+bool check(Board const& board, std::string const& solution) {
+  if(not board.run(solution))
+    return false;
+  for(size_t length = 0; length < solution.size() and length <= 8; ++length) {
+    std::string commands(length, Solver::command(0));
+    do {
+      if(board.run(commands))
+        return false;
+    } while(next_sequence(commands));
+  }
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  bool ok = true;
+  for(int i = 1; i < argc; ++i) {
+    Board board{argv[i]};
+    std::string solution, by_grid;
+    bool const solved = Solver(board).solve(solution);
+    if(solved != Solver(Grid(board)).solve(by_grid) or solution.size() != by_grid.size()) {
+      std::cout << argv[i] << ": the board and its grid disagree!" << std::endl;
+      ok = false;
+    }
+    else if(not solved) {
+      std::cout << argv[i] << ": no way out" << std::endl;
+    }
+    else if(check(board, solution)) {
+      std::cout << argv[i] << ": " << solution << std::endl;
+    }
+    else {
+      std::cout << argv[i] << ": " << solution << " is not a shortest way out!" << std::endl;
+      ok = false;
+    }
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+#ifndef RICOCHET_ROBOT_SOLVER_HPP
+#define RICOCHET_ROBOT_SOLVER_HPP
+
+/* Shortest way out
+ *
+ * The robot position is the whole state of the game, so a breadth first
+ * search over the cells of the board finds the shortest sequence of
+ * commands from the entrance to an exit. Where the robot stops is computed
+ * once for every cell and direction, so that following an edge of the search
+ * is a single table load.
+ *
+ * That table is filled by sweeping each row and column once per direction:
+ * the robot stops on a cell whose next neighbour blocks, otherwise where it
+ * would stop from that neighbour. Blocking cells, that the robot never
+ * stands on, stop on themselves.
+ */
+
+#include "ricochet_robot.hpp"
+
+#include <vector>
+#include <cstdint>
+
+class Solver {
+  public:
+
+  static constexpr size_t NbCommands = 4;
+  static char command(size_t c) { return "hjkl"[c]; }
+
+  // from a Board or a Grid
+  template<class B>
+  explicit Solver(B const& board) :
+    stops_(board.size()),
+    wins_(board.size()),
+    entrance_(board.entrance())
+  {
+    size_t const size = board.size(),
+                 stride = board.stride();
+    // commands are h, j, k and l, in that order
+    for(size_t cell = 0; cell < size; ++cell) {
+      wins_[cell] = board.wins(cell);
+      if(board.blocks(cell))
+        stops_[cell].fill(cell);
+      else {
+        stops_[cell][0] = board.blocks(cell - 1) ? cell : stops_[cell - 1][0];
+        stops_[cell][2] = board.blocks(cell - stride) ? cell : stops_[cell - stride][2];
+      }
+    }
+    for(size_t cell = size; cell-- > 0;) {
+      if(not board.blocks(cell)) {
+        stops_[cell][3] = board.blocks(cell + 1) ? cell : stops_[cell + 1][3];
+        stops_[cell][1] = board.blocks(cell + stride) ? cell : stops_[cell + stride][1];
+      }
+    }
+  }
+
+  /* Store in commands the shortest way from the entrance to an exit and return
+   * true, or return false when there is none
+   */
+  bool solve(std::string& commands) const {
+    constexpr std::uint32_t unseen = ~std::uint32_t(0);
+    std::vector<std::uint32_t> from(stops_.size(), unseen);
+    std::vector<char> how(stops_.size());
+    std::vector<std::uint32_t> queue;
+    queue.reserve(stops_.size());
+
+    from[entrance_] = entrance_;
+    queue.push_back(entrance_);
+    for(size_t head = 0; head < queue.size(); ++head) {
+      std::uint32_t const cell = queue[head];
+      if(wins_[cell]) {
+        commands.clear();
+        for(std::uint32_t c = cell; c != entrance_; c = from[c])
+          commands.push_back(how[c]);
+        std::reverse(commands.begin(), commands.end());
+        return true;
+      }
+      for(size_t c = 0; c < NbCommands; ++c) {
+        std::uint32_t const next = stops_[cell][c];
+        if(from[next] == unseen) {
+          from[next] = cell;
+          how[next] = command(c);
+          queue.push_back(next);
+        }
+      }
+    }
+    return false;
+  }
+
+  private:
+
+  std::vector<std::array<std::uint32_t, NbCommands>> stops_;
+  std::vector<bool> wins_;
+  std::uint32_t entrance_;
+};
+
+#endif
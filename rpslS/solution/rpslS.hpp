@@ -0,0 +1,139 @@
+#ifndef RPSLS_HPP
+#define RPSLS_HPP
+
+#include <iostream>
+#include <string>
+#include <array>
+#include <random>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+enum class Weapon {
+    ROCK,
+    PAPER,
+    SCISSOR,
+    LIZARD,
+    SPOCK
+};
+
+/* Weapon -> stream */
+struct BadWeapon {};
+inline std::istream& operator>>(std::istream& is, Weapon& w) {
+    char c;
+    is >> c;
+    switch(c) {
+        case 'r': w = Weapon::ROCK; break;
+        case 'p': w = Weapon::PAPER; break;
+        case 's': w = Weapon::SCISSOR; break;
+        case 'l': w = Weapon::LIZARD; break;
+        case 'S': w = Weapon::SPOCK; break;
+		default:  throw BadWeapon();
+    };
+    return is;
+}
+inline std::ostream& operator<<(std::ostream& os, Weapon w) {
+    switch(w) {
+        case Weapon::ROCK: return os << "rock";
+        case Weapon::PAPER: return os << "paper";
+        case Weapon::SCISSOR: return os << "scissor";
+        case Weapon::LIZARD: return os << "lizard";
+        case Weapon::SPOCK: return os << "Spock";
+        default: assert(false && "this should never happen");
+    };
+    return os;
+}
+
+enum class Status {
+    LOSE,
+    DRAW,
+    WIN
+};
+
+constexpr std::array<std::array<Status, 5> const, 5> Matrix = {{
+    /* Rock */      { Status::DRAW, Status::LOSE, Status::WIN, Status::WIN, Status::LOSE },
+    /* Paper */     { Status::WIN, Status::DRAW, Status::LOSE, Status::LOSE, Status::WIN },
+    /* Scissors */  { Status::LOSE, Status::WIN, Status::DRAW, Status::WIN, Status::LOSE },
+    /* Lizard */    { Status::LOSE, Status::WIN, Status::LOSE, Status::DRAW, Status::WIN },
+    /* Spock */     { Status::WIN, Status::LOSE, Status::WIN, Status::LOSE, Status::DRAW }
+}};
+
+inline Status outcome(Weapon mine, Weapon theirs) {
+    return Matrix[static_cast<int>(mine)][static_cast<int>(theirs)];
+}
+
+/* first weapon, in Matrix order, winning against w */
+inline Weapon counter(Weapon w) {
+    for(size_t i = 0; i < Matrix.size(); ++i)
+        if(Matrix[i][static_cast<int>(w)] == Status::WIN)
+            return static_cast<Weapon>(i);
+    assert(false && "every weapon can be beaten");
+    return w;
+}
+
+/* a mixed strategy: the probability of playing each weapon, in Matrix order */
+using Strategy = std::array<double, 5>;
+
+/* Strategy -> stream, as five probabilities on a line */
+struct BadStrategy {};
+inline std::istream& operator>>(std::istream& is, Strategy& s) {
+    double total = 0;
+    for(double& p : s) {
+        if(not(is >> p) or p < 0)
+            throw BadStrategy();
+        total += p;
+    }
+    if(total <= 0)
+        throw BadStrategy();
+    return is;
+}
+inline std::ostream& operator<<(std::ostream& os, Strategy const& s) {
+    for(size_t i = 0; i < s.size(); ++i)
+        os << (i ? " " : "") << s[i];
+    return os;
+}
+
+/* Strategies
+ *
+ * A strategy picks its next move with weapon(), then observe() tells it what
+ * both players played. Each is built from a seed, even when it does not draw
+ * anything, so that the tournament can build any of them the same way.
+ */
+
+class AI {
+    std::default_random_engine rengine_;
+    std::uniform_int_distribution<int> uniform_dist_;
+    std::discrete_distribution<int> dist_;
+    bool uniform_;  // all weapons equally likely: uniform_dist_ is enough
+
+    public:
+
+    AI() :
+        AI(std::random_device()())
+    {
+    }
+
+    explicit AI(std::uint64_t seed) :
+        AI(Strategy{{1, 1, 1, 1, 1}}, seed)
+    {
+    }
+
+    /* play each weapon with the given (unnormalized) probability */
+    explicit AI(Strategy const& strategy, std::uint64_t seed = std::random_device()()) :
+        rengine_(seed),
+        uniform_dist_(0, Matrix.size() - 1),
+        dist_(strategy.begin(), strategy.end()),
+        uniform_(std::all_of(strategy.begin(), strategy.end(),
+                             [&strategy](double p) { return p == strategy[0]; }))
+    {
+    }
+
+    Weapon weapon() {
+        return static_cast<Weapon>(uniform_ ? uniform_dist_(rengine_) : dist_(rengine_));
+    }
+
+    void observe(Weapon, Weapon) {
+    }
+};
+
+#endif
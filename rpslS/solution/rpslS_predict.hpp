@@ -0,0 +1,75 @@
+#ifndef RPSLS_PREDICT_HPP
+#define RPSLS_PREDICT_HPP
+
+/* An AI that learns from its opponent
+ *
+ * PredictiveAI<Order> models the opponent as an order-Order Markov chain: the
+ * last Order weapons it played form a base-5 history code, and a flat table
+ * holds, for each code, the payoff each of our weapons would have earned
+ * against what the opponent played next. Observing a move adds one payoff
+ * row to one table row and shifts the history code, picking a weapon is an
+ * argmax over five values, so both are constant time whatever the order.
+ *
+ * When no weapon shows a positive payoff in the current history, the AI plays
+ * uniformly at random, which is the best it can do without information.
+ */
+
+#include "rpslS.hpp"
+
+#include <vector>
+
+namespace details {
+    constexpr size_t pow(size_t base, size_t exp) {
+        return exp == 0 ? 1 : base * pow(base, exp - 1);
+    }
+}
+
+template<size_t Order>
+class PredictiveAI {
+    static constexpr size_t NbWeapons = 5;
+    static constexpr size_t NbHistories = details::pow(NbWeapons, Order);
+
+    using Row = std::array<std::int32_t, NbWeapons>;
+
+    std::default_random_engine rengine_;
+    std::uniform_int_distribution<int> uniform_dist_;
+    std::vector<Row> payoffs_;
+    size_t history_ = 0;
+
+    public:
+
+    PredictiveAI() :
+        PredictiveAI(std::random_device()())
+    {
+    }
+
+    explicit PredictiveAI(std::uint64_t seed) :
+        rengine_(seed),
+        uniform_dist_(0, NbWeapons - 1),
+        payoffs_(NbHistories, Row{{0, 0, 0, 0, 0}})
+    {
+        static_assert(Order > 0, "at least one weapon of history");
+    }
+
+    Weapon weapon() {
+        Row const& row = payoffs_[history_];
+        size_t best = 0;
+        for(size_t w = 1; w < NbWeapons; ++w)
+            if(row[w] > row[best])
+                best = w;
+        if(row[best] <= 0)
+            return static_cast<Weapon>(uniform_dist_(rengine_));
+        return static_cast<Weapon>(best);
+    }
+
+    void observe(Weapon, Weapon theirs) {
+        size_t const t = static_cast<size_t>(theirs);
+        Row& row = payoffs_[history_];
+        // LOSE, DRAW and WIN are 0, 1 and 2, hence payoffs of -1, 0 and 1
+        for(size_t w = 0; w < NbWeapons; ++w)
+            row[w] += static_cast<int>(Matrix[w][t]) - 1;
+        history_ = (history_ * NbWeapons + t) % NbHistories;
+    }
+};
+
+#endif
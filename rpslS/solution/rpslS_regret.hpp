@@ -0,0 +1,102 @@
+#ifndef RPSLS_REGRET_HPP
+#define RPSLS_REGRET_HPP
+
+/* Equilibrium strategies through regret matching
+ *
+ * Two RegretMatcher play each other. At each iteration both draw a weapon
+ * from their current strategy, then each one adds to the regret of every
+ * weapon what it would have earned against the opponent's weapon, minus what
+ * it actually earned: a whole payoff column at once, five independent
+ * additions the compiler vectorizes. The next strategy plays each weapon in
+ * proportion to its positive regret. The average of the successive strategies
+ * converges to an equilibrium.
+ *
+ * Payoffs come from Matrix, a win with weapon w earning weights[w] and a loss
+ * against w costing weights[w]. The game stays symmetric and zero sum, so
+ * both players converge towards the same strategies.
+ */
+
+#include "rpslS.hpp"
+
+#include <algorithm>
+
+/* Payoff[mine][theirs] */
+using Payoff = std::array<std::array<double, 5>, 5>;
+
+inline Payoff make_payoff(std::array<double, 5> const& weights) {
+    Payoff payoff;
+    for(size_t i = 0; i < Matrix.size(); ++i)
+        for(size_t j = 0; j < Matrix.size(); ++j)
+            switch(Matrix[i][j]) {
+                case Status::WIN: payoff[i][j] = weights[i]; break;
+                case Status::LOSE: payoff[i][j] = -weights[j]; break;
+                case Status::DRAW: payoff[i][j] = 0; break;
+            }
+    return payoff;
+}
+
+/* expected payoff of each weapon against the opponent's strategy */
+inline std::array<double, 5> expected(Payoff const& payoff, Strategy const& theirs) {
+    std::array<double, 5> values{{0, 0, 0, 0, 0}};
+    for(size_t i = 0; i < payoff.size(); ++i)
+        for(size_t j = 0; j < payoff.size(); ++j)
+            values[i] += payoff[i][j] * theirs[j];
+    return values;
+}
+
+/* what a best response to either strategy wins on average; 0 at equilibrium */
+inline double exploitability(Payoff const& payoff, Strategy const& first, Strategy const& second) {
+    std::array<double, 5> against_second = expected(payoff, second),
+                          against_first = expected(payoff, first);
+    return (*std::max_element(against_second.begin(), against_second.end()) +
+            *std::max_element(against_first.begin(), against_first.end())) / 2;
+}
+
+class RegretMatcher {
+    std::array<double, 5> regrets_{{0, 0, 0, 0, 0}};
+    Strategy total_{{0, 0, 0, 0, 0}};
+    Strategy current_{{.2, .2, .2, .2, .2}};
+
+    public:
+
+    Strategy const& current() const {
+        return current_;
+    }
+
+    /* the average of all strategies played so far */
+    Strategy average() const {
+        Strategy avg = total_;
+        double sum = 0;
+        for(double p : avg)
+            sum += p;
+        for(double& p : avg)
+            p = sum > 0 ? p / sum : 1. / avg.size();
+        return avg;
+    }
+
+    /* a weapon from the current strategy, given u uniform in [0, 1) */
+    Weapon draw(double u) const {
+        size_t w = 0;
+        for(double acc = current_[0]; w + 1 < current_.size() and u >= acc; acc += current_[++w])
+            ;
+        return static_cast<Weapon>(w);
+    }
+
+    /* we played mine against theirs */
+    void update(Payoff const& payoff, Weapon mine, Weapon theirs) {
+        size_t const m = static_cast<size_t>(mine),
+                     t = static_cast<size_t>(theirs);
+        double const earned = payoff[m][t];
+        double positive = 0;
+        for(size_t w = 0; w < regrets_.size(); ++w) {
+            total_[w] += current_[w];
+            regrets_[w] += payoff[w][t] - earned;
+            current_[w] = std::max(regrets_[w], 0.);
+            positive += current_[w];
+        }
+        for(size_t w = 0; w < current_.size(); ++w)
+            current_[w] = positive > 0 ? current_[w] / positive : 1. / current_.size();
+    }
+};
+
+#endif
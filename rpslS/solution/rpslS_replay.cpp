@@ -0,0 +1,167 @@
+/* Replay of recorded games
+ *
+ * A record is a stream of rounds, each one being the weapon of the player
+ * then the weapon of the AI, as typed in the game (r, p, s, l or S). Spaces
+ * are ignored, anything else is counted as invalid and skipped.
+ *
+ * The whole record is read at once, from a file or from the standard input.
+ * A 256 entries table then turns each character into a weapon code, and the
+ * codes are compacted block by block without a branch before being counted
+ * by pair. Scores only come from the 25 pair counters and Matrix at the end,
+ * and the report is written at once. The time spent reading and replaying
+ * goes to the standard error, in moves/s.
+ *
+ * With -g, writes a record of random rounds instead, to feed benchmarks.
+ */
+
+#include "rpslS.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <sstream>
+#include <chrono>
+
+namespace {
+
+constexpr std::uint8_t Space = 5,
+                       Invalid = 6;
+
+struct Codes {
+    std::uint8_t of[256];
+};
+
+constexpr Codes make_codes() {
+    Codes codes{};
+    for(int c = 0; c < 256; ++c)
+        codes.of[c] = Invalid;
+    codes.of[static_cast<unsigned char>('r')] = static_cast<std::uint8_t>(Weapon::ROCK);
+    codes.of[static_cast<unsigned char>('p')] = static_cast<std::uint8_t>(Weapon::PAPER);
+    codes.of[static_cast<unsigned char>('s')] = static_cast<std::uint8_t>(Weapon::SCISSOR);
+    codes.of[static_cast<unsigned char>('l')] = static_cast<std::uint8_t>(Weapon::LIZARD);
+    codes.of[static_cast<unsigned char>('S')] = static_cast<std::uint8_t>(Weapon::SPOCK);
+    for(char c : {' ', '\t', '\n', '\r', '\v', '\f'})
+        codes.of[static_cast<unsigned char>(c)] = Space;
+    return codes;
+}
+
+constexpr Codes codes = make_codes();
+
+struct Tally {
+    std::uint64_t pairs[5][5] = {};
+    std::uint64_t invalid = 0;
+    bool incomplete = false;
+};
+
+Tally replay(char const* data, size_t size) {
+    Tally tally;
+    constexpr size_t Block = 4096;
+    std::uint8_t weapons[Block + 1];
+    size_t pending = 0;   // 1 when a player weapon waits for the AI one
+    for(size_t start = 0; start < size; start += Block) {
+        size_t const end = std::min(size, start + Block);
+        size_t n = pending;
+        for(size_t i = start; i < end; ++i) {
+            std::uint8_t code = codes.of[static_cast<unsigned char>(data[i])];
+            weapons[n] = code;
+            n += code < Space;
+            tally.invalid += code == Invalid;
+        }
+        size_t i = 0;
+        for(; i + 1 < n; i += 2)
+            ++tally.pairs[weapons[i]][weapons[i + 1]];
+        pending = n - i;
+        weapons[0] = weapons[i];
+    }
+    tally.incomplete = pending;
+    return tally;
+}
+
+bool read_all(std::FILE* input, std::vector<char>& data) {
+    size_t size = 0;
+    data.resize(1 << 20);
+    while(size_t n = std::fread(data.data() + size, 1, data.size() - size, input)) {
+        size += n;
+        if(size == data.size())
+            data.resize(2 * data.size());
+    }
+    data.resize(size);
+    return not std::ferror(input);
+}
+
+int generate(std::uint64_t rounds, std::uint64_t seed) {
+    std::mt19937_64 rengine(seed);
+    char const weapons[] = "rpslS";
+    std::vector<char> buffer;
+    buffer.reserve(1 << 16);
+    for(std::uint64_t r = 0; r < rounds; ++r) {
+        std::uint64_t x = rengine();
+        buffer.push_back(weapons[(x & 0xffffffff) * 5 >> 32]);
+        buffer.push_back(weapons[(x >> 32) * 5 >> 32]);
+        buffer.push_back('\n');
+        if(buffer.size() + 3 > buffer.capacity()) {
+            std::fwrite(buffer.data(), 1, buffer.size(), stdout);
+            buffer.clear();
+        }
+    }
+    std::fwrite(buffer.data(), 1, buffer.size(), stdout);
+    return std::fflush(stdout) == 0 ? 0 : 1;
+}
+
+int usage(char const *progname) {
+    std::cerr << "usage: " << progname << " [record_file]" << std::endl
+              << "       " << progname << " -g <rounds> <seed>" << std::endl;
+    return 1;
+}
+
+}
+
+int main(int argc, char * argv[]) {
+    if(argc == 4 and std::strcmp(argv[1], "-g") == 0) {
+        return generate(std::stoull(argv[2]), std::stoull(argv[3]));
+    }
+    if(argc > 2) {
+        return usage(argv[0]);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::FILE* input = argc == 2 ? std::fopen(argv[1], "rb") : stdin;
+    if(not input) {
+        std::cerr << "cannot open " << argv[1] << std::endl;
+        return 1;
+    }
+    std::vector<char> data;
+    bool ok = read_all(input, data);
+    if(input != stdin)
+        std::fclose(input);
+    if(not ok) {
+        std::cerr << "cannot read the record" << std::endl;
+        return 1;
+    }
+    auto read = std::chrono::steady_clock::now();
+    Tally tally = replay(data.data(), data.size());
+    auto replayed = std::chrono::steady_clock::now();
+
+    std::uint64_t outcomes[3] = {0, 0, 0};
+    for(size_t i = 0; i < Matrix.size(); ++i)
+        for(size_t j = 0; j < Matrix.size(); ++j)
+            outcomes[static_cast<int>(Matrix[i][j])] += tally.pairs[i][j];
+    std::uint64_t rounds = outcomes[0] + outcomes[1] + outcomes[2];
+
+    std::ostringstream report;
+    report << "rounds:     " << rounds << '\n'
+           << "Your score: " << outcomes[static_cast<int>(Status::WIN)] << '\n'
+           << "AI score:   " << outcomes[static_cast<int>(Status::LOSE)] << '\n'
+           << "draws:      " << outcomes[static_cast<int>(Status::DRAW)] << '\n';
+    if(tally.invalid)
+        report << "invalid:    " << tally.invalid << " characters skipped\n";
+    if(tally.incomplete)
+        report << "the last round misses the AI weapon\n";
+    std::cout << report.str() << std::flush;
+
+    std::chrono::duration<double> reading = read - start,
+                                  replaying = replayed - read;
+    std::cerr << "read " << data.size() / reading.count() / 1e6 << "MB/s, replayed "
+              << 2 * rounds / replaying.count() / 1e6 << "M moves/s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,180 @@
+/* Headless tournament between strategies
+ *
+ * Every strategy plays every other one for a given number of rounds. Rounds
+ * are split among threads, each one building its own pair of strategies from
+ * a seed of its own and counting outcomes locally; counts are only merged
+ * once all threads are done. For each match the program reports the rates of
+ * wins, draws and losses of the first strategy, with a 95% confidence
+ * interval, and the number of rounds played per second.
+ */
+
+#include "rpslS.hpp"
+#include "rpslS_predict.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include <string>
+
+/* always the same weapon */
+struct Rock {
+    static char const* name() { return "rock"; }
+    explicit Rock(std::uint64_t) {}
+    Weapon weapon() { return Weapon::ROCK; }
+    void observe(Weapon, Weapon) {}
+};
+
+/* every weapon in turn */
+class Cycle {
+    int next_ = 0;
+    public:
+    static char const* name() { return "cycle"; }
+    explicit Cycle(std::uint64_t) {}
+    Weapon weapon() {
+        Weapon w = static_cast<Weapon>(next_);
+        next_ = (next_ + 1) % Matrix.size();
+        return w;
+    }
+    void observe(Weapon, Weapon) {}
+};
+
+/* the opponent's last weapon */
+class Copycat {
+    Weapon last_ = Weapon::ROCK;
+    public:
+    static char const* name() { return "copycat"; }
+    explicit Copycat(std::uint64_t) {}
+    Weapon weapon() { return last_; }
+    void observe(Weapon, Weapon theirs) { last_ = theirs; }
+};
+
+/* what beats the opponent's last weapon */
+class Counter {
+    Weapon next_ = Weapon::ROCK;
+    public:
+    static char const* name() { return "counter"; }
+    explicit Counter(std::uint64_t) {}
+    Weapon weapon() { return next_; }
+    void observe(Weapon, Weapon theirs) { next_ = counter(theirs); }
+};
+
+struct Uniform : AI {
+    static char const* name() { return "uniform"; }
+    using AI::AI;
+};
+
+template<size_t Order>
+struct Markov : PredictiveAI<Order> {
+    static std::string name() { return "markov" + std::to_string(Order); }
+    using PredictiveAI<Order>::PredictiveAI;
+};
+
+/* outcomes of the first player, indexed by Status */
+using Outcomes = std::array<std::uint64_t, 3>;
+
+struct Config {
+    std::uint64_t seed;
+    std::uint64_t rounds;
+    unsigned nb_threads;
+};
+
+/* splitmix64, to derive well spread seeds from the tournament seed */
+static
+std::uint64_t mix(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+}
+
+template<class First, class Second>
+Outcomes play(Config const& config) {
+    std::vector<Outcomes> counts(config.nb_threads, Outcomes{{0, 0, 0}});
+    std::vector<std::thread> workers;
+    for(unsigned t = 0; t < config.nb_threads; ++t) {
+        workers.emplace_back([&counts, &config, t]() {
+            First first(mix(config.seed + 2 * t));
+            Second second(mix(config.seed + 2 * t + 1));
+            Outcomes local{{0, 0, 0}};
+            std::uint64_t begin = config.rounds * t / config.nb_threads,
+                          end = config.rounds * (t + 1) / config.nb_threads;
+            for(std::uint64_t i = begin; i < end; ++i) {
+                Weapon w1 = first.weapon(),
+                       w2 = second.weapon();
+                ++local[static_cast<int>(outcome(w1, w2))];
+                first.observe(w1, w2);
+                second.observe(w2, w1);
+            }
+            counts[t] = local;
+        });
+    }
+    for(std::thread& worker : workers)
+        worker.join();
+
+    Outcomes merged{{0, 0, 0}};
+    for(Outcomes const& local : counts)
+        for(size_t s = 0; s < merged.size(); ++s)
+            merged[s] += local[s];
+    return merged;
+}
+
+/* rate with the half width of its 95% confidence interval */
+static
+void report(char const* what, std::uint64_t count, std::uint64_t rounds) {
+    double p = double(count) / rounds;
+    double half_width = 1.96 * std::sqrt(p * (1 - p) / rounds);
+    std::cout << "  " << what << ' ' << std::setw(6) << 100 * p << "% +-" << 100 * half_width;
+}
+
+template<class First, class Second>
+void match(Config const& config) {
+    auto start = std::chrono::steady_clock::now();
+    Outcomes outcomes = play<First, Second>(config);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << std::setw(8) << First::name() << " vs " << std::setw(8) << Second::name();
+    report("win", outcomes[static_cast<int>(Status::WIN)], config.rounds);
+    report("draw", outcomes[static_cast<int>(Status::DRAW)], config.rounds);
+    report("lose", outcomes[static_cast<int>(Status::LOSE)], config.rounds);
+    std::cout << "  " << config.rounds / elapsed.count() / 1e6 << "M rounds/s" << std::endl;
+}
+
+template<class... Strategies>
+struct Tournament {
+    template<class First>
+    static void against_all(Config const& config) {
+        int expand[] = {0, (match<First, Strategies>(config), 0)...};
+        (void)expand;
+    }
+
+    static void run(Config const& config) {
+        int expand[] = {0, (against_all<Strategies>(config), 0)...};
+        (void)expand;
+    }
+};
+
+static
+int usage(char const *progname) {
+    std::cerr << "usage: " << progname << " <seed> <threads> <rounds>" << std::endl;
+    return 1;
+}
+
+int main(int argc, char * argv[]) {
+    if(argc != 4) {
+        return usage(argv[0]);
+    }
+    std::uint64_t seed = std::stoull(argv[1]);
+    int nb_threads = std::stoi(argv[2]);
+    long long rounds = std::stoll(argv[3]);
+    if(nb_threads <= 0 or rounds <= 0) {
+        return usage(argv[0]);
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    Tournament<Uniform, Rock, Cycle, Copycat, Counter, Markov<1>, Markov<3>, Markov<5>>::run(
+            Config{seed, std::uint64_t(rounds), unsigned(nb_threads)});
+    return 0;
+}
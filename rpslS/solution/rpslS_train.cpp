@@ -0,0 +1,116 @@
+/* Self-play training of an equilibrium strategy
+ *
+ * Runs several independent regret matching self-plays, one per thread, each
+ * from a seed of its own, then averages their average strategies and writes
+ * the result to a file the game can load (see rpslS <n> <strategy_file>).
+ * Along the way it reports the exploitability of the strategies after 10,
+ * 100, ... iterations, averaged over the runs, and iterations/s.
+ *
+ * Optional weights give the payoff of a win with each weapon, see
+ * rpslS_regret.hpp.
+ */
+
+#include "rpslS.hpp"
+#include "rpslS_regret.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <thread>
+#include <chrono>
+
+struct Run {
+    Strategy strategy;          // average of both players
+    std::vector<double> exploitabilities;   // after 10, 100, ... iterations
+};
+
+static
+Run self_play(Payoff const& payoff, std::uint64_t seed, std::uint64_t iterations) {
+    std::mt19937_64 rengine(seed);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    RegretMatcher first, second;
+    Run run;
+    std::uint64_t checkpoint = 10;
+    for(std::uint64_t i = 1; i <= iterations; ++i) {
+        Weapon w1 = first.draw(uniform(rengine)),
+               w2 = second.draw(uniform(rengine));
+        first.update(payoff, w1, w2);
+        second.update(payoff, w2, w1);
+        if(i == checkpoint) {
+            run.exploitabilities.push_back(exploitability(payoff, first.average(), second.average()));
+            checkpoint *= 10;
+        }
+    }
+    Strategy a1 = first.average(),
+             a2 = second.average();
+    for(size_t w = 0; w < run.strategy.size(); ++w)
+        run.strategy[w] = (a1[w] + a2[w]) / 2;
+    return run;
+}
+
+static
+int usage(char const *progname) {
+    std::cerr << "usage: " << progname << " <seed> <runs> <iterations> <strategy_file> [<rock> <paper> <scissor> <lizard> <Spock> weights]" << std::endl;
+    return 1;
+}
+
+int main(int argc, char * argv[]) {
+    if(argc != 5 and argc != 10) {
+        return usage(argv[0]);
+    }
+    std::uint64_t seed = std::stoull(argv[1]);
+    int nb_runs = std::stoi(argv[2]);
+    long long iterations = std::stoll(argv[3]);
+    if(nb_runs <= 0 or iterations <= 0) {
+        return usage(argv[0]);
+    }
+    std::array<double, 5> weights{{1, 1, 1, 1, 1}};
+    if(argc == 10) {
+        for(size_t w = 0; w < weights.size(); ++w) {
+            weights[w] = std::stod(argv[5 + w]);
+            if(weights[w] <= 0)
+                return usage(argv[0]);
+        }
+    }
+    Payoff const payoff = make_payoff(weights);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Run> runs(nb_runs);
+    std::vector<std::thread> workers;
+    for(int r = 0; r < nb_runs; ++r) {
+        workers.emplace_back([&runs, &payoff, seed, iterations, r]() {
+            runs[r] = self_play(payoff, seed + r, iterations);
+        });
+    }
+    for(std::thread& worker : workers)
+        worker.join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "iterations\texploitability" << std::endl;
+    std::uint64_t checkpoint = 10;
+    for(size_t c = 0; c < runs[0].exploitabilities.size(); ++c, checkpoint *= 10) {
+        double mean = 0;
+        for(Run const& run : runs)
+            mean += run.exploitabilities[c];
+        std::cout << checkpoint << '\t' << mean / nb_runs << std::endl;
+    }
+
+    Strategy strategy{{0, 0, 0, 0, 0}};
+    for(Run const& run : runs)
+        for(size_t w = 0; w < strategy.size(); ++w)
+            strategy[w] += run.strategy[w] / nb_runs;
+
+    std::cout << nb_runs * double(iterations) / elapsed.count() / 1e6 << "M iterations/s" << std::endl
+              << "strategy: " << strategy << std::endl
+              << "exploitability of the averaged strategy: "
+              << exploitability(payoff, strategy, strategy) << std::endl;
+
+    std::ofstream output(argv[4]);
+    output.precision(17);
+    output << strategy << std::endl;
+    if(not output) {
+        std::cerr << "cannot write " << argv[4] << std::endl;
+        return 1;
+    }
+    return 0;
+}
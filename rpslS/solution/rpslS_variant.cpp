@@ -0,0 +1,69 @@
+/* Table or arithmetic?
+ *
+ * For several numbers of weapons, checks that the compile time table of
+ * Variant<N> matches its rule, then resolves the same random pairs of
+ * weapons through both, reporting lookups/s. The table is N * N Status, so
+ * it leaves the caches as N grows while the rule stays a few instructions,
+ * which the compiler can even vectorize at -O3.
+ */
+
+#include "rpslS_variant.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+
+using Pair = std::array<std::uint16_t, 2>;
+
+template<class F>
+double measure(std::vector<Pair> const& pairs, size_t rounds, long& checksum, F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    for(size_t r = 0; r < rounds; ++r)
+        for(Pair const& p : pairs)
+            checksum += static_cast<int>(f(p[0], p[1]));
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return rounds * pairs.size() / elapsed.count() / 1e6;
+}
+
+template<size_t N>
+bool bench(size_t nb_pairs, size_t rounds) {
+    static constexpr typename Variant<N>::Table table = Variant<N>::table();
+
+    for(size_t i = 0; i < N; ++i)
+        for(size_t j = 0; j < N; ++j)
+            if(table.cells[i][j] != Variant<N>::outcome(i, j)) {
+                std::cout << N << " weapons: the table differs from the rule!" << std::endl;
+                return false;
+            }
+
+    std::mt19937 rengine(N);
+    std::uniform_int_distribution<std::uint16_t> dist(0, N - 1);
+    std::vector<Pair> pairs(nb_pairs);
+    for(Pair& p : pairs)
+        p = Pair{{dist(rengine), dist(rengine)}};
+
+    long by_table = 0, by_rule = 0;
+    double table_rate = measure(pairs, rounds, by_table,
+            [](size_t a, size_t b) { return table.cells[a][b]; });
+    double rule_rate = measure(pairs, rounds, by_rule,
+            [](size_t a, size_t b) { return Variant<N>::outcome(a, b); });
+
+    std::cout << std::setw(5) << N << " weapons, " << std::setw(8) << sizeof(table) / 1024. << "kB table: "
+              << std::setw(8) << table_rate << "M lookups/s by table, "
+              << std::setw(8) << rule_rate << "M lookups/s by rule" << std::endl;
+    return by_table == by_rule;
+}
+
+int main(int argc, char * argv[]) {
+    size_t const nb_pairs = 1 << 20;
+    size_t const rounds = argc > 1 ? std::stoul(argv[1]) : 20;
+
+    std::cout << std::fixed << std::setprecision(1);
+    bool ok = bench<5>(nb_pairs, rounds) and
+              bench<7>(nb_pairs, rounds) and
+              bench<15>(nb_pairs, rounds) and
+              bench<101>(nb_pairs, rounds) and
+              bench<501>(nb_pairs, rounds);
+    return ok ? 0 : 1;
+}
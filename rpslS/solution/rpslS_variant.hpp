@@ -0,0 +1,75 @@
+#ifndef RPSLS_VARIANT_HPP
+#define RPSLS_VARIANT_HPP
+
+/* Rock-paper-scissors with N weapons
+ *
+ * Put the N weapons on a circle: each one beats the (N - 1) / 2 weapons
+ * preceding it at an odd distance and loses against the others, so that a
+ * beats b when (a - b) mod N is odd. With an odd N, every weapon wins and
+ * loses the same number of times. Weapons are just indices here; N = 5 is
+ * the classical game once its weapons are put in circle order, see position.
+ *
+ * Variant<N>::outcome computes the rule; Variant<N>::table() tabulates it at
+ * compile time, for comparison, at the cost of N * N entries.
+ */
+
+#include "rpslS.hpp"
+
+template<size_t N>
+struct Variant {
+    static_assert(N >= 3 and N % 2 == 1, "a balanced game needs an odd number of weapons");
+
+    struct Table {
+        Status cells[N][N];
+    };
+
+    /* (mine - theirs) mod N is mine - theirs, or mine - theirs + N when
+     * negative, which flips its parity since N is odd: no division needed.
+     * That parity is 0 for a draw, so LOSE, DRAW and WIN (0, 1 and 2) come
+     * without a branch either */
+    static constexpr Status outcome(size_t mine, size_t theirs) {
+        return static_cast<Status>((mine == theirs) + 2 * (((mine ^ theirs) ^ (mine < theirs)) & 1));
+    }
+
+    static constexpr Table table() {
+        Table t{};
+        for(size_t i = 0; i < N; ++i)
+            for(size_t j = 0; j < N; ++j)
+                t.cells[i][j] = outcome(i, j);
+        return t;
+    }
+
+    static constexpr bool balanced() {
+        for(size_t i = 0; i < N; ++i) {
+            size_t wins = 0, loses = 0;
+            for(size_t j = 0; j < N; ++j) {
+                wins += outcome(i, j) == Status::WIN;
+                loses += outcome(i, j) == Status::LOSE;
+            }
+            if(wins != (N - 1) / 2 or loses != (N - 1) / 2)
+                return false;
+        }
+        return true;
+    }
+};
+
+/* place of a Weapon on the circle of Variant<5>: rock, paper, scissor, Spock, lizard */
+constexpr size_t position(Weapon w) {
+    constexpr size_t positions[] = {0, 1, 2, 4, 3};
+    return positions[static_cast<size_t>(w)];
+}
+
+namespace details {
+    constexpr bool same_as_matrix() {
+        for(size_t i = 0; i < Matrix.size(); ++i)
+            for(size_t j = 0; j < Matrix.size(); ++j)
+                if(Variant<5>::outcome(position(static_cast<Weapon>(i)), position(static_cast<Weapon>(j))) != Matrix[i][j])
+                    return false;
+        return true;
+    }
+}
+
+static_assert(details::same_as_matrix(), "Variant<5> is rock-paper-scissors-lizard-Spock");
+static_assert(Variant<5>::balanced() and Variant<7>::balanced() and Variant<101>::balanced(), "fair games");
+
+#endif
@@ -0,0 +1,205 @@
+/* .~= Waldo factory =~.
+ *
+ * Stamps out many puzzles from a single picture, for load tests. The picture
+ * is loaded, validated and indexed once; each puzzle is then just a copy of it
+ * with one character patched to a Waldo.
+ *
+ * By default only the patches are written, one `<offset> <character>' line
+ * per puzzle. With --full, whole pictures are written, sharing the unpatched
+ * parts of the base picture through writev instead of copying them.
+ */
+
+#include "waldo_picture.hpp"
+
+#include <iostream>  // for std::cerr
+#include <string>    // for std::string
+#include <vector>    // for std::vector
+#include <thread>    // for std::thread
+#include <chrono>    // for std::chrono::steady_clock
+#include <cstdint>   // for std::uint64_t
+#include <cstring>   // for std::strcmp
+#include <climits>   // for IOV_MAX
+#include <algorithm> // for std::copy and std::max
+
+#include <unistd.h>
+#include <sys/uio.h>
+
+// xoshiro256** by Blackman and Vigna, seeded through splitmix64
+class Xoshiro256 {
+    std::uint64_t s_[4];
+
+    static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    public:
+
+    explicit Xoshiro256(std::uint64_t seed) {
+        for(std::uint64_t& s : s_) {
+            std::uint64_t z = (seed += 0x9e3779b97f4a7c15);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            s = z ^ (z >> 31);
+        }
+    }
+
+    std::uint64_t operator()() {
+        std::uint64_t const result = rotl(s_[1] * 5, 7) * 9;
+        std::uint64_t const t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+        return result;
+    }
+
+    // advance by 2^128 draws, giving non-overlapping streams to each thread
+    void jump() {
+        static const std::uint64_t polynomial[] = {
+            0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c
+        };
+        std::uint64_t s[4] = {0, 0, 0, 0};
+        for(std::uint64_t p : polynomial)
+            for(int b = 0; b < 64; ++b) {
+                if(p & std::uint64_t(1) << b)
+                    for(int i = 0; i < 4; ++i)
+                        s[i] ^= s_[i];
+                (*this)();
+            }
+        std::copy(s, s + 4, s_);
+    }
+
+    // uniform in [0, bound), Lemire's multiply and shift with rejection
+    std::uint64_t below(std::uint64_t bound) {
+        unsigned __int128 m = static_cast<unsigned __int128>((*this)()) * bound;
+        std::uint64_t low = static_cast<std::uint64_t>(m);
+        if(low < bound) {
+            std::uint64_t const threshold = -bound % bound;
+            while(low < threshold) {
+                m = static_cast<unsigned __int128>((*this)()) * bound;
+                low = static_cast<std::uint64_t>(m);
+            }
+        }
+        return m >> 64;
+    }
+};
+
+// A picture ready to hide Waldo over and over again
+class PuzzleBatch : public Waldo {
+    public:
+
+    PuzzleBatch(std::string const& path) : Waldo(path, Unhidden{}) {
+        index_hiding_spots();
+        if(hiding_spots().empty())
+            throw InvalidWaldo("no place to hide Waldo");
+    }
+
+    // pick the Waldo offset of `count' puzzles, each thread with its own engine
+    std::vector<size_t> generate(size_t count, unsigned nb_threads, std::uint64_t seed) const {
+        std::vector<size_t> offsets(count);
+        std::vector<std::thread> workers;
+        Xoshiro256 engine(seed);
+        for(unsigned t = 0; t < nb_threads; ++t) {
+            workers.emplace_back([this, &offsets, count, nb_threads, t, engine]() mutable {
+                std::vector<size_t> const& spots = hiding_spots();
+                for(size_t i = count * t / nb_threads; i < count * (t + 1) / nb_threads; ++i)
+                    offsets[i] = spots[engine.below(spots.size())];
+            });
+            engine.jump();
+        }
+        for(std::thread& worker : workers)
+            worker.join();
+        return offsets;
+    }
+
+    // write the patch of each puzzle
+    void write_patches(std::vector<size_t> const& offsets, int fd) const {
+        std::string buffer;
+        for(size_t offset : offsets) {
+            buffer += std::to_string(offset);
+            buffer += ' ';
+            buffer += waldo;
+            buffer += '\n';
+            if(buffer.size() >= 1 << 16)
+                flush(buffer, fd);
+        }
+        flush(buffer, fd);
+    }
+
+    // write each puzzle as the base picture around a one character patch
+    void write_pictures(std::vector<size_t> const& offsets, int fd) const {
+        static const char patch = waldo;
+        PictureView const base = str();
+        std::vector<iovec> chunks;
+        for(size_t offset : offsets) {
+            chunks.push_back({const_cast<char*>(base.data()), offset});
+            chunks.push_back({const_cast<char*>(&patch), 1});
+            chunks.push_back({const_cast<char*>(base.data() + offset + 1), base.size() - offset - 1});
+            if(chunks.size() + 3 > IOV_MAX)
+                flush(chunks, fd);
+        }
+        flush(chunks, fd);
+    }
+
+    private:
+    static void flush(std::string& buffer, int fd) {
+        for(size_t done = 0; done < buffer.size();) {
+            ssize_t n = write(fd, buffer.data() + done, buffer.size() - done);
+            if(n < 0)
+                throw std::runtime_error("failed to write puzzles");
+            done += n;
+        }
+        buffer.clear();
+    }
+
+    static void flush(std::vector<iovec>& chunks, int fd) {
+        iovec* first = chunks.data();
+        iovec* last = first + chunks.size();
+        while(first != last) {
+            ssize_t n = writev(fd, first, last - first);
+            if(n < 0)
+                throw std::runtime_error("failed to write puzzles");
+            // skip what has been written, possibly in the middle of a chunk
+            for(; first != last and size_t(n) >= first->iov_len; ++first)
+                n -= first->iov_len;
+            if(first != last) {
+                first->iov_base = static_cast<char*>(first->iov_base) + n;
+                first->iov_len -= n;
+            }
+        }
+        chunks.clear();
+    }
+};
+
+static
+int usage(char const *progname) {
+    std::cerr << "usage: " << progname << " <picture> <count> [--full]" << std::endl;
+    return 1;
+}
+
+int main(int argc, char * argv[]) {
+    if(argc != 3 and not (argc == 4 and not std::strcmp(argv[3], "--full")))
+        return usage(argv[0]);
+
+    long long count = std::stoll(argv[2]);
+    if(count <= 0)
+        return usage(argv[0]);
+
+    PuzzleBatch batch{argv[1]};
+    auto start = std::chrono::steady_clock::now();
+
+    unsigned nb_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> offsets = batch.generate(count, nb_threads, std::random_device()());
+    auto generated = std::chrono::steady_clock::now();
+
+    if(argc == 4)
+        batch.write_pictures(offsets, STDOUT_FILENO);
+    else
+        batch.write_patches(offsets, STDOUT_FILENO);
+    auto end = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double> generation = generated - start, total = end - start;
+    std::cerr << count << " puzzles: " << count / generation.count() << " puzzles/s generated, "
+              << count / total.count() << " puzzles/s written" << std::endl;
+    return 0;
+}
@@ -0,0 +1,158 @@
+/* .~= Where was Waldo? =~.
+ *
+ * The other way around: given a (possibly huge) picture, report the line and
+ * column of every Waldo hidden in it.
+ *
+ * The picture is memory mapped and split in one chunk per thread. Each thread
+ * scans its chunk once, 16 characters at a time, locating Waldos and counting
+ * newlines with the same vector loads. Lines and columns are first computed
+ * relative to the chunk, then fixed up with a prefix sum over the chunks, so
+ * that no thread ever looks at data from another chunk.
+ */
+
+#include "waldo_picture.hpp"
+
+#include <iostream>  // for std::cout
+#include <string>    // for std::stoi
+#include <vector>    // for std::vector
+#include <thread>    // for std::thread
+#include <chrono>    // for std::chrono::steady_clock
+#include <algorithm> // for std::min
+#include <functional> // for std::ref
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h> // for the _mm_* intrinsics
+#endif
+
+static const size_t npos = -1;
+
+// a Waldo found in a chunk, with its line relative to the chunk start
+struct Match {
+    size_t pos;           //< offset in the picture
+    size_t line;          //< number of newlines between the chunk start and pos
+    size_t line_start;    //< offset of the line start, npos if before the chunk
+};
+
+// what a thread learns about its chunk
+struct Chunk {
+    size_t begin, end;
+    size_t lines = 0;         //< newlines in the chunk
+    size_t last_newline = npos; //< offset of the last one
+    std::vector<Match> matches;
+};
+
+static
+void scan(char const* data, Chunk& chunk) {
+    size_t i = chunk.begin;
+
+#ifdef __SSE2__
+    __m128i const newline = _mm_set1_epi8('\n');
+    __m128i const hidden = _mm_set1_epi8(Waldo::waldo);
+    for(; i + 16 <= chunk.end; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i));
+        unsigned newlines = _mm_movemask_epi8(_mm_cmpeq_epi8(block, newline));
+        unsigned waldos = _mm_movemask_epi8(_mm_cmpeq_epi8(block, hidden));
+        while(waldos) {
+            unsigned bit = __builtin_ctz(waldos);
+            unsigned before = newlines & ((1u << bit) - 1);
+            size_t line_start = before ? i + 32 - __builtin_clz(before)
+                              : chunk.last_newline == npos ? npos
+                              : chunk.last_newline + 1;
+            chunk.matches.push_back({i + bit, chunk.lines + __builtin_popcount(before), line_start});
+            waldos &= waldos - 1;
+        }
+        if(newlines) {
+            chunk.lines += __builtin_popcount(newlines);
+            chunk.last_newline = i + 31 - __builtin_clz(newlines);
+        }
+    }
+#endif
+
+    for(; i < chunk.end; ++i) {
+        if(data[i] == Waldo::waldo) {
+            size_t line_start = chunk.last_newline == npos ? npos : chunk.last_newline + 1;
+            chunk.matches.push_back({i, chunk.lines, line_start});
+        }
+        else if(data[i] == '\n') {
+            chunk.lines += 1;
+            chunk.last_newline = i;
+        }
+    }
+}
+
+static
+int usage(char const *progname) {
+    std::cerr << "usage: " << progname << " <picture> [threads]" << std::endl;
+    return 1;
+}
+
+int main(int argc, char * argv[]) {
+    if(argc != 2 and argc != 3)
+        return usage(argv[0]);
+
+    int nb_threads = argc == 3 ? std::stoi(argv[2]) : std::thread::hardware_concurrency();
+    if(nb_threads <= 0)
+        nb_threads = 1;
+
+    int fd = open(argv[1], O_RDONLY);
+    struct stat st;
+    if(fd < 0 or fstat(fd, &st)) {
+        std::cerr << "cannot open " << argv[1] << std::endl;
+        return 1;
+    }
+    size_t const size = st.st_size;
+    if(size == 0) {
+        close(fd);
+        return 0;
+    }
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(mapping == MAP_FAILED) {
+        std::cerr << "cannot map " << argv[1] << std::endl;
+        return 1;
+    }
+    char const* data = static_cast<char const*>(mapping);
+
+    auto start = std::chrono::steady_clock::now();
+
+    // one chunk per thread, aligned on vector loads
+    std::vector<Chunk> chunks(nb_threads);
+    size_t const stride = (size / nb_threads + 15) & ~size_t(15);
+    for(int t = 0; t < nb_threads; ++t) {
+        chunks[t].begin = std::min(size, t * stride);
+        chunks[t].end = t + 1 == nb_threads ? size : std::min(size, (t + 1) * stride);
+    }
+
+    std::vector<std::thread> workers;
+    for(Chunk& chunk : chunks)
+        workers.emplace_back(scan, data, std::ref(chunk));
+    for(std::thread& worker : workers)
+        worker.join();
+
+    // prefix sum over the chunks, only touching their matches
+    size_t lines = 0, last_newline = npos, found = 0;
+    for(Chunk const& chunk : chunks) {
+        for(Match const& match : chunk.matches) {
+            size_t line_start = match.line_start == npos ? last_newline + 1 : match.line_start;
+            std::cout << "line " << lines + match.line + 1
+                      << ", column " << match.pos - line_start + 1 << '\n';
+        }
+        found += chunk.matches.size();
+        lines += chunk.lines;
+        if(chunk.last_newline != npos)
+            last_newline = chunk.last_newline;
+    }
+    std::cout.flush();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cerr << found << " Waldo(s) in " << size << " bytes with " << nb_threads << " thread(s): "
+              << elapsed.count() * 1000 << "ms, " << size / elapsed.count() / 1e9 << "GB/s" << std::endl;
+
+    munmap(mapping, size);
+    return found ? 0 : 1;
+}
@@ -0,0 +1,73 @@
+/* .~= Waldo loading benchmark =~.
+ *
+ * Compares the time and memory taken to load a picture and change one of its
+ * characters, either by reading it in a string through a stream, as Waldo
+ * used to, or through the privately mapped storage of the Waldo class.
+ *
+ * Each mode is meant to run in its own process, so that the resident set
+ * sizes do not interfere.
+ */
+
+#include "waldo_picture.hpp"
+
+#include <iostream>  // for std::cout
+#include <fstream>   // for std::ifstream
+#include <string>    // for std::string
+#include <chrono>    // for std::chrono::steady_clock
+
+// Waldo loader, without the hiding part
+struct Loader : Waldo {
+    Loader(std::string const& path) : Waldo(path, Unhidden{}) {}
+    void patch(size_t pos) { picture()[pos] = waldo; }
+};
+
+// anonymous and file backed resident memory, in kB
+static
+void resident(long& anonymous, long& file) {
+    std::ifstream status("/proc/self/status");
+    for(std::string key; status >> key;) {
+        if(key == "RssAnon:")
+            status >> anonymous;
+        else if(key == "RssFile:")
+            status >> file;
+    }
+}
+
+static
+int usage(char const *progname) {
+    std::cerr << "usage: " << progname << " <picture> stream|mmap" << std::endl;
+    return 1;
+}
+
+int main(int argc, char * argv[]) {
+    if(argc != 3)
+        return usage(argv[0]);
+    std::string const mode = argv[2];
+    if(mode != "stream" and mode != "mmap")
+        return usage(argv[0]);
+
+    long anonymous_before = 0, file_before = 0, anonymous = 0, file = 0;
+    resident(anonymous_before, file_before);
+    auto start = std::chrono::steady_clock::now();
+
+    size_t size;
+    if(mode == "stream") {
+        std::ifstream ifs(argv[1]);
+        std::string picture{std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+        size = picture.size();
+        picture[size / 2] = Waldo::waldo;
+        resident(anonymous, file);
+    }
+    else {
+        Loader picture{argv[1]};
+        size = picture.str().size();
+        picture.patch(size / 2);
+        resident(anonymous, file);
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << mode << ": " << size << " bytes loaded in " << elapsed.count() * 1000 << "ms, RSS +"
+              << anonymous - anonymous_before << "kB anonymous, +"
+              << file - file_before << "kB file backed" << std::endl;
+    return 0;
+}
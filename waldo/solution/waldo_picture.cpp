@@ -0,0 +1,189 @@
+#include "waldo_picture.hpp"
+
+#include <fstream>   // for std::ifstream
+#include <cctype>    // for std::isspace
+#include <unordered_set> // for std::unordered_set
+#include <algorithm> // for std::swap
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h> // for the _mm_* intrinsics
+#endif
+
+const char Waldo::waldo;
+const char Waldo::decoy;
+
+// create a Waldo instance from a file description
+// the description is assumed to be an asciiart image
+// with at least one line and always the same number of columns
+Waldo::Waldo(std::string const & path, size_t count, size_t decoys) : Waldo(path, Unhidden{})
+{
+    index_hiding_spots();
+    hide_waldos(count, decoys);
+}
+
+Waldo::Waldo(std::string const & path, Unhidden) : rnd_(std::random_device()())
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if(fd >= 0 and not fstat(fd, &st) and S_ISREG(st.st_mode) and st.st_size > 0) {
+        void* mapping = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if(mapping != MAP_FAILED) {
+            picture_ = static_cast<char*>(mapping);
+            size_ = st.st_size;
+            mapped_ = true;
+        }
+    }
+    if(fd >= 0)
+        close(fd);
+
+    if(not mapped_) {
+        std::ifstream ifs(path);
+        buffer_ = std::string{std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+        picture_ = &buffer_[0];
+        size_ = buffer_.size();
+    }
+
+    // the destructor won't run if we raise from here
+    try {
+        check_validity();
+    }
+    catch(...) {
+        if(mapped_)
+            munmap(picture_, size_);
+        throw;
+    }
+}
+
+Waldo::~Waldo() {
+    if(mapped_)
+        munmap(picture_, size_);
+}
+
+// a single write (or a few, for huge pictures) straight from the mapping
+void Waldo::print(int fd) const {
+    for(size_t done = 0; done < size_;) {
+        ssize_t n = write(fd, picture_ + done, size_ - done);
+        if(n < 0)
+            throw std::runtime_error("failed to print the picture");
+        done += n;
+    }
+}
+
+// check some stuff on the picture and raise if needed
+void Waldo::check_validity() const {
+    Census const c = census();
+    if(c.lines == 0)
+        throw InvalidWaldo("not even a single line");
+    if(c.waldo)
+        throw InvalidWaldo("Waldo symbol already in input file");
+    if(not c.symbol)
+        throw InvalidWaldo("input file full of blank");
+}
+
+Waldo::Census Waldo::census() const {
+    Census c;
+    char const* data = picture_;
+    size_t const size = size_;
+    size_t i = 0;
+
+#ifdef __SSE2__
+    // newlines are counted 16 at a time while Waldo and non-blank characters
+    // are accumulated in vector masks, only inspected once at the end
+    __m128i const newline = _mm_set1_epi8('\n');
+    __m128i const hidden = _mm_set1_epi8(waldo);
+    __m128i const space = _mm_set1_epi8(' ');
+    __m128i const tab = _mm_set1_epi8('\t');
+    __m128i waldos = _mm_setzero_si128();
+    __m128i blanks = _mm_set1_epi8(-1);
+    for(; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i));
+        c.lines += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline)));
+        waldos = _mm_or_si128(waldos, _mm_cmpeq_epi8(chunk, hidden));
+        blanks = _mm_and_si128(blanks, _mm_or_si128(_mm_cmpeq_epi8(chunk, space),
+                                                     _mm_cmpeq_epi8(chunk, tab)));
+    }
+    c.waldo = _mm_movemask_epi8(waldos) != 0;
+    c.symbol = _mm_movemask_epi8(blanks) != 0xffff;
+#endif
+
+    for(; i < size; ++i) {
+        c.lines += data[i] == '\n';
+        c.waldo |= data[i] == waldo;
+        c.symbol |= not std::isblank(static_cast<unsigned char>(data[i]));
+    }
+    return c;
+}
+
+// record the position of every non-space character of the picture
+void Waldo::index_hiding_spots() {
+    hiding_spots_.clear();
+    char const* data = picture_;
+    size_t const size = size_;
+    size_t i = 0;
+
+#ifdef __SSE2__
+    // flag the spaces of 16 characters at once, then compact the positions
+    // of the others out of the resulting bit mask
+    __m128i const space = _mm_set1_epi8(' ');
+    __m128i const tab = _mm_set1_epi8('\t');
+    __m128i const nb_controls = _mm_set1_epi8('\r' - '\t');
+    for(; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i));
+        // '\t', '\n', '\v', '\f' and '\r' are contiguous
+        __m128i offset = _mm_sub_epi8(chunk, tab);
+        __m128i controls = _mm_cmpeq_epi8(_mm_min_epu8(offset, nb_controls), offset);
+        __m128i spaces = _mm_or_si128(_mm_cmpeq_epi8(chunk, space), controls);
+        unsigned mask = ~_mm_movemask_epi8(spaces) & 0xffff;
+        while(mask) {
+            hiding_spots_.push_back(i + __builtin_ctz(mask));
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    for(; i < size; ++i)
+        if(not std::isspace(static_cast<unsigned char>(data[i])))
+            hiding_spots_.push_back(i);
+}
+
+// modify the string `from' to hide a Waldo in a non-space location
+void Waldo::hide_waldo() {
+    hide_waldos(1, 0);
+}
+
+// hide Waldos and decoys in distinct non-space locations
+// k = count + decoys draws, each one a constant time lookup in the flat
+// index: O(k) whatever the size of the picture
+void Waldo::hide_waldos(size_t count, size_t decoys) {
+    size_t const n = hiding_spots_.size();
+    size_t const k = count + decoys;
+    if(n == 0)
+        throw InvalidWaldo("no place to hide Waldo");
+    if(k > n)
+        throw InvalidWaldo("not enough places to hide every Waldo");
+
+    // Floyd's algorithm: k distinct indices, uniformly, in k draws
+    std::unordered_set<size_t> picked(k);
+    std::vector<size_t> spots;
+    spots.reserve(k);
+    for(size_t j = n - k; j < n; ++j) {
+        size_t t = std::uniform_int_distribution<size_t>(0, j)(rnd_);
+        if(not picked.insert(t).second) {
+            picked.insert(j);
+            t = j;
+        }
+        spots.push_back(t);
+    }
+
+    // the pick order is not uniform, shuffle it before handing out the roles
+    for(size_t i = 0; i < count and i + 1 < k; ++i)
+        std::swap(spots[i], spots[std::uniform_int_distribution<size_t>(i, k - 1)(rnd_)]);
+
+    for(size_t i = 0; i < k; ++i)
+        picture_[hiding_spots_[spots[i]]] = i < count ? waldo : decoy;
+}
@@ -0,0 +1,85 @@
+#ifndef WALDO_PICTURE_HPP
+#define WALDO_PICTURE_HPP
+
+#include <random>    // for std::default_random_engine
+#include <string>    // for std::string
+#include <stdexcept> // for std::runtime_error
+#include <vector>    // for std::vector
+
+// An exception specialized fro Waldo Errors
+struct InvalidWaldo : std::runtime_error {
+    InvalidWaldo(char const what[] = "") : std::runtime_error(what)
+    {
+    }
+};
+
+// A read-only view over the characters of a picture
+class PictureView {
+    char const* data_;
+    size_t size_;
+
+    public:
+    PictureView(char const* data, size_t size) : data_(data), size_(size) {}
+
+    char const* data() const { return data_; }
+    size_t size() const { return size_; }
+    char const* begin() const { return data_; }
+    char const* end() const { return data_ + size_; }
+    char operator[](size_t i) const { return data_[i]; }
+};
+
+// Handle loading and display of Waldo picture
+//
+// The picture file is mapped privately, so that only the pages where
+// something gets hidden are ever copied. Files that cannot be mapped
+// are read in memory instead.
+class Waldo {
+    char* picture_ = nullptr;  //< the picture itself
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::string buffer_;       //< storage for unmapped pictures
+    std::vector<size_t> hiding_spots_; //< positions of non-space characters
+    std::default_random_engine rnd_;   //< seeded once per picture
+
+    public:
+
+    // constructor, hiding `count' Waldos and `decoys' look-alikes
+    Waldo(std::string const& path, size_t count = 1, size_t decoys = 0);
+    ~Waldo();
+
+    Waldo(Waldo const&) = delete;
+    Waldo& operator=(Waldo const&) = delete;
+
+    // common accessors
+    PictureView str() const { return {picture_, size_}; }
+
+    // write the whole picture to `fd'
+    void print(int fd) const;
+
+    static const char waldo = 'w';
+    static const char decoy = 'v';
+
+    protected:
+    // load and validate a picture, leaving Waldo out of it
+    struct Unhidden {};
+    Waldo(std::string const& path, Unhidden);
+
+    // helper functions
+    void hide_waldo();
+    void hide_waldos(size_t count, size_t decoys);
+    void check_validity() const;
+    void index_hiding_spots();
+    std::vector<size_t> const& hiding_spots() const { return hiding_spots_; }
+    char* picture() { return picture_; }
+
+    private:
+    // what check_validity needs to know, gathered in a single pass
+    struct Census {
+        size_t lines = 0;     //< number of '\n'
+        bool waldo = false;   //< a Waldo symbol is already there
+        bool symbol = false;  //< at least a non-blank character
+    };
+    Census census() const;
+};
+
+#endif
@@ -0,0 +1,239 @@
+/* .~= Where are Waldo and his friends? =~.
+ *
+ * Looks for whole multi-line sprites, not just a single character, inside a
+ * Waldo picture. The picture goes through the regular Waldo loader and its
+ * validation, but nothing gets hidden in it.
+ *
+ * This is a two dimensional Rabin-Karp: each picture row gets a rolling hash
+ * of every sprite-wide window, and these row hashes are in turn combined by a
+ * rolling hash along the columns. A window whose hash matches a sprite hash is
+ * then compared character by character, so reported matches are exact.
+ *
+ * Sprites of the same size share their hashes, and the picture is split in
+ * bands of rows processed by different threads.
+ */
+
+#include "waldo_picture.hpp"
+
+#include <iostream>  // for std::cout
+#include <fstream>   // for std::ifstream
+#include <string>    // for std::string
+#include <vector>    // for std::vector
+#include <map>       // for std::map
+#include <thread>    // for std::thread
+#include <cstdint>   // for std::uint64_t
+#include <cstring>   // for std::memcmp
+#include <algorithm> // for std::sort, std::find and std::max
+
+// A rectangular piece of ASCII art, short rows are padded with spaces
+struct Sprite {
+    std::string name;
+    size_t height = 0, width = 0;
+    std::string pixels;  //< height rows of width characters
+
+    Sprite(std::string const& path);
+    char const* row(size_t r) const { return pixels.data() + r * width; }
+};
+
+Sprite::Sprite(std::string const& path) : name(path) {
+    std::ifstream ifs(path);
+    std::vector<std::string> lines;
+    for(std::string line; std::getline(ifs, line);) {
+        lines.push_back(line);
+        width = std::max(width, line.size());
+    }
+    height = lines.size();
+    if(height == 0 or width == 0)
+        throw InvalidWaldo("empty sprite");
+    for(std::string& line : lines)
+        pixels += line.append(width - line.size(), ' ');
+}
+
+// A sprite found in the picture
+struct Match {
+    size_t line, column;
+    size_t sprite;
+    bool operator<(Match const& other) const {
+        return line != other.line ? line < other.line
+             : column != other.column ? column < other.column
+             : sprite < other.sprite;
+    }
+};
+
+// A Waldo picture that can be searched for sprites
+class SpriteFinder : public Waldo {
+    size_t height_ = 0, width_ = 0;
+    std::string grid_;  //< the picture lines, padded with spaces to width_
+
+    // rolling hash bases for rows and columns, arithmetic is modulo 2^64
+    static const std::uint64_t row_base = 0x100000001b3;
+    static const std::uint64_t column_base = 0x9e3779b97f4a7c15;
+
+    // sprites of the same size, sorted by hash
+    struct Group {
+        size_t height, width;
+        std::vector<std::pair<std::uint64_t, size_t>> hashes;
+    };
+
+    public:
+
+    SpriteFinder(std::string const& path);
+
+    std::vector<Match> find(std::vector<Sprite> const& sprites, unsigned nb_threads) const;
+
+    private:
+    static std::uint64_t power(std::uint64_t base, size_t exponent);
+    static void row_hashes(char const* row, size_t size, size_t width, std::uint64_t* out);
+    static std::uint64_t hash(Sprite const& sprite);
+
+    void scan(Group const& group, std::vector<Sprite> const& sprites,
+              size_t first, size_t last, std::vector<Match>& matches) const;
+};
+
+SpriteFinder::SpriteFinder(std::string const& path) : Waldo(path, Unhidden{}) {
+    PictureView const picture = str();
+    std::vector<std::pair<char const*, char const*>> lines;
+    for(char const* start = picture.begin(); start < picture.end();) {
+        char const* end = std::find(start, picture.end(), '\n');
+        lines.emplace_back(start, end);
+        width_ = std::max<size_t>(width_, end - start);
+        start = end + 1;
+    }
+    height_ = lines.size();
+    grid_.assign(height_ * width_, ' ');
+    for(size_t r = 0; r < height_; ++r)
+        std::copy(lines[r].first, lines[r].second, &grid_[r * width_]);
+}
+
+std::uint64_t SpriteFinder::power(std::uint64_t base, size_t exponent) {
+    std::uint64_t result = 1;
+    while(exponent--)
+        result *= base;
+    return result;
+}
+
+// hash of every `width'-wide window of `row', rolled from left to right
+void SpriteFinder::row_hashes(char const* row, size_t size, size_t width, std::uint64_t* out) {
+    std::uint64_t const outgoing = power(row_base, width);
+    std::uint64_t h = 0;
+    for(size_t c = 0; c < width; ++c)
+        h = h * row_base + static_cast<unsigned char>(row[c]);
+    out[0] = h;
+    for(size_t c = 1; c + width <= size; ++c) {
+        h = h * row_base + static_cast<unsigned char>(row[c + width - 1])
+                         - static_cast<unsigned char>(row[c - 1]) * outgoing;
+        out[c] = h;
+    }
+}
+
+std::uint64_t SpriteFinder::hash(Sprite const& sprite) {
+    std::uint64_t h = 0, r;
+    for(size_t i = 0; i < sprite.height; ++i) {
+        row_hashes(sprite.row(i), sprite.width, sprite.width, &r);
+        h = h * column_base + r;
+    }
+    return h;
+}
+
+// look for the sprites of `group' with their top row in [first, last)
+void SpriteFinder::scan(Group const& group, std::vector<Sprite> const& sprites,
+                        size_t first, size_t last, std::vector<Match>& matches) const {
+    size_t const height = group.height;
+    size_t const windows = width_ - group.width + 1;
+    std::uint64_t const outgoing = power(column_base, height - 1);
+
+    // the row hashes of the last `height' rows, and their column hash
+    std::vector<std::uint64_t> ring(height * windows);
+    std::vector<std::uint64_t> column(windows, 0);
+
+    for(size_t r = first; r < last + height - 1; ++r) {
+        std::uint64_t* slot = &ring[(r - first) % height * windows];
+        if(r - first >= height)
+            for(size_t c = 0; c < windows; ++c)
+                column[c] -= slot[c] * outgoing;
+        row_hashes(&grid_[r * width_], width_, group.width, slot);
+        for(size_t c = 0; c < windows; ++c)
+            column[c] = column[c] * column_base + slot[c];
+
+        if(r + 1 < first + height)
+            continue;
+        size_t const top = r + 1 - height;
+        for(size_t c = 0; c < windows; ++c) {
+            auto candidates = std::equal_range(group.hashes.begin(), group.hashes.end(),
+                                               std::make_pair(column[c], size_t(0)),
+                                               [](std::pair<std::uint64_t, size_t> const& a,
+                                                  std::pair<std::uint64_t, size_t> const& b) {
+                                                   return a.first < b.first;
+                                               });
+            for(auto it = candidates.first; it != candidates.second; ++it) {
+                Sprite const& sprite = sprites[it->second];
+                bool same = true;
+                for(size_t i = 0; same and i < height; ++i)
+                    same = not std::memcmp(&grid_[(top + i) * width_ + c], sprite.row(i), sprite.width);
+                if(same)
+                    matches.push_back({top, c, it->second});
+            }
+        }
+    }
+}
+
+std::vector<Match> SpriteFinder::find(std::vector<Sprite> const& sprites, unsigned nb_threads) const {
+    // sprites of the same size share their row and column hashes
+    std::map<std::pair<size_t, size_t>, Group> by_size;
+    for(size_t i = 0; i < sprites.size(); ++i) {
+        Sprite const& sprite = sprites[i];
+        if(sprite.height > height_ or sprite.width > width_)
+            continue;
+        Group& group = by_size[std::make_pair(sprite.height, sprite.width)];
+        group.height = sprite.height;
+        group.width = sprite.width;
+        group.hashes.emplace_back(hash(sprite), i);
+    }
+    for(auto& entry : by_size)
+        std::sort(entry.second.hashes.begin(), entry.second.hashes.end());
+
+    // each thread handles a band of rows for every group
+    nb_threads = std::max(1u, nb_threads);
+    std::vector<std::vector<Match>> found(nb_threads);
+    std::vector<std::thread> workers;
+    for(unsigned t = 0; t < nb_threads; ++t) {
+        workers.emplace_back([this, &by_size, &sprites, &found, nb_threads, t]() {
+            for(auto const& entry : by_size) {
+                Group const& group = entry.second;
+                size_t const tops = height_ - group.height + 1;
+                size_t const first = tops * t / nb_threads;
+                size_t const last = tops * (t + 1) / nb_threads;
+                if(first != last)
+                    scan(group, sprites, first, last, found[t]);
+            }
+        });
+    }
+    for(std::thread& worker : workers)
+        worker.join();
+
+    std::vector<Match> matches;
+    for(std::vector<Match> const& band : found)
+        matches.insert(matches.end(), band.begin(), band.end());
+    std::sort(matches.begin(), matches.end());
+    return matches;
+}
+
+static
+int usage(char const *progname) {
+    std::cerr << "usage: " << progname << " <picture> <sprite>..." << std::endl;
+    return 1;
+}
+
+int main(int argc, char * argv[]) {
+    if(argc < 3)
+        return usage(argv[0]);
+
+    SpriteFinder picture{argv[1]};
+    std::vector<Sprite> sprites(argv + 2, argv + argc);
+
+    std::vector<Match> matches = picture.find(sprites, std::thread::hardware_concurrency());
+    for(Match const& match : matches)
+        std::cout << sprites[match.sprite].name << " at line " << match.line + 1
+                  << ", column " << match.column + 1 << std::endl;
+    return matches.empty() ? 1 : 0;
+}